@@ -0,0 +1,79 @@
+// Copyright (c) 2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <string>
+#include <gflags/gflags.h>
+#include <iostream>
+
+/// @brief message for help argument
+static const char help_message[] = "Print a usage message.";
+
+/// @brief message for the selection of the layers
+static const char layers_message[] =
+    "Optional. Comma separated layer types or case names to run, e.g. \"MVN,Resample/nearest_x2\" (default is all).";
+static const char list_message[] = "List the layer cases and exit.";
+
+/// @brief message for the thread counts
+static const char threads_message[] =
+    "Optional. Comma separated OpenMP thread counts (default is 1, 2, 4, ... up to all cores).";
+
+/// @brief message for the length of the run
+static const char iterations_message[] =
+    "Specify number of measured executions of each layer (default is 100).";
+static const char warmup_message[] =
+    "Specify number of executions of each layer before measuring (default is 10).";
+
+/// @brief message for the report
+static const char json_message[] = "Print the report as JSON.";
+
+/// \brief Define flag for showing help message <br>
+DEFINE_bool(h, false, help_message);
+
+/// \brief selection of the layers <br>
+DEFINE_string(layers, "", layers_message);
+DEFINE_bool(list, false, list_message);
+
+/// \brief thread counts <br>
+DEFINE_string(nthreads, "", threads_message);
+
+/// \brief length of the run <br>
+DEFINE_uint32(niter, 100, iterations_message);
+DEFINE_uint32(warmup, 10, warmup_message);
+
+/// \brief report format <br>
+DEFINE_bool(json, false, json_message);
+
+/**
+* \brief This function show a help message
+*/
+static void showUsage() {
+  std::cout << std::endl;
+  std::cout << "cpu_extension_bench [OPTION]" << std::endl;
+  std::cout << "Options:" << std::endl;
+  std::cout << std::endl;
+  std::cout << "    -h                         " << help_message << std::endl;
+  std::cout << "    -layers \"<list>\"           " << layers_message
+            << std::endl;
+  std::cout << "    -list                      " << list_message << std::endl;
+  std::cout << "    -nthreads \"<list>\"         " << threads_message
+            << std::endl;
+  std::cout << "    -niter \"<num>\"             " << iterations_message
+            << std::endl;
+  std::cout << "    -warmup \"<num>\"            " << warmup_message
+            << std::endl;
+  std::cout << "    -json                      " << json_message << std::endl;
+}
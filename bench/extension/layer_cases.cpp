@@ -0,0 +1,1164 @@
+/**
+ * @brief a file with the cpu_extension layer cases and their scalar
+ * references
+ * @file layer_cases.cpp
+ */
+#include "layer_cases.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+using InferenceEngine::Blob;
+using InferenceEngine::SizeVector;
+
+namespace {
+const float *data(const Blob::Ptr &blob) {
+  return blob->cbuffer().as<const float *>();
+}
+
+size_t count(const SizeVector &dims) {
+  size_t size = 1;
+  for (auto dim : dims) {
+    size *= dim;
+  }
+  return size;
+}
+
+void fillUniform(float *data, size_t size, float low, float high,
+                 std::mt19937 *rng) {
+  std::uniform_real_distribution<float> distribution(low, high);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = distribution(*rng);
+  }
+}
+
+float logistic(float x) { return 1.f / (1.f + std::exp(-x)); }
+
+/**
+ * @brief Fill image info as height, width and scale.
+ */
+void fillImageInfo(float *data, size_t size, float height, float width) {
+  std::fill(data, data + size, 1.f);
+  data[0] = height;
+  data[1] = width;
+}
+
+/**
+ * @brief Fill a [N, 5] rois blob with boxes of batch 0 inside the image.
+ */
+void fillRois(float *data, size_t size, float height, float width,
+              std::mt19937 *rng) {
+  std::uniform_real_distribution<float> x(0, width - 1);
+  std::uniform_real_distribution<float> y(0, height - 1);
+  std::uniform_real_distribution<float> side(16, 256);
+  for (size_t i = 0; i + 5 <= size; i += 5) {
+    data[i] = 0;
+    data[i + 1] = x(*rng);
+    data[i + 2] = y(*rng);
+    data[i + 3] = std::min(data[i + 1] + side(*rng), width - 1);
+    data[i + 4] = std::min(data[i + 2] + side(*rng), height - 1);
+  }
+}
+
+ExtensionBench::LayerCase makeGRN() {
+  ExtensionBench::LayerCase layer_case;
+  layer_case.name = "GRN/ssd_conv4_3";
+  layer_case.type = "GRN";
+  layer_case.params = {{"bias", "1e-06"}};
+  layer_case.inputs = {{1, 256, 38, 38}};
+  layer_case.outputs = {{1, 256, 38, 38}};
+  layer_case.reference = [](const std::vector<Blob::Ptr> &inputs,
+                            float *output) {
+    const float *src = data(inputs[0]);
+    SizeVector dims = inputs[0]->getTensorDesc().getDims();
+    size_t channels = dims[1], spatial = dims[2] * dims[3];
+    for (size_t b = 0; b < dims[0]; ++b) {
+      for (size_t i = 0; i < spatial; ++i) {
+        size_t base = b * channels * spatial + i;
+        double sum = 0;
+        for (size_t c = 0; c < channels; ++c) {
+          sum += src[base + c * spatial] * src[base + c * spatial];
+        }
+        double norm = std::sqrt(sum + 1e-06);
+        for (size_t c = 0; c < channels; ++c) {
+          output[base + c * spatial] =
+              static_cast<float>(src[base + c * spatial] / norm);
+        }
+      }
+    }
+  };
+  return layer_case;
+}
+
+ExtensionBench::LayerCase makeMVN(bool across_channels, bool blocked) {
+  ExtensionBench::LayerCase layer_case;
+  layer_case.name = across_channels ? "MVN/across_channels" : "MVN/per_channel";
+  layer_case.type = "MVN";
+  layer_case.params = {{"across_channels", across_channels ? "1" : "0"},
+                       {"normalize_variance", "1"},
+                       {"eps", "1e-09"}};
+  layer_case.inputs = {{1, 64, 112, 112}};
+  layer_case.outputs = {{1, 64, 112, 112}};
+  if (blocked) {
+    layer_case.name += "_blocked";
+    layer_case.blocked = true;
+    // the last block of 8 or 16 channels is padded
+    layer_case.inputs = {{1, 20, 112, 112}};
+    layer_case.outputs = {{1, 20, 112, 112}};
+  }
+  layer_case.tolerance = 1e-4f;
+  layer_case.reference = [across_channels](
+      const std::vector<Blob::Ptr> &inputs, float *output) {
+    const float *src = data(inputs[0]);
+    SizeVector dims = inputs[0]->getTensorDesc().getDims();
+    size_t group = across_channels ? count(dims) / dims[0] :
+                   dims[2] * dims[3];
+    for (size_t start = 0; start < count(dims); start += group) {
+      double mean = 0;
+      for (size_t i = start; i < start + group; ++i) {
+        mean += src[i];
+      }
+      mean /= group;
+      double variance = 0;
+      for (size_t i = start; i < start + group; ++i) {
+        variance += (src[i] - mean) * (src[i] - mean);
+      }
+      double deviation = std::sqrt(variance / group) + 1e-09;
+      for (size_t i = start; i < start + group; ++i) {
+        output[i] = static_cast<float>((src[i] - mean) / deviation);
+      }
+    }
+  };
+  return layer_case;
+}
+
+ExtensionBench::LayerCase makeNormalize() {
+  const size_t channels = 512;
+  std::vector<float> weights(channels);
+  for (size_t c = 0; c < channels; ++c) {
+    weights[c] = 10.f + 0.01f * c;
+  }
+  ExtensionBench::LayerCase layer_case;
+  layer_case.name = "Normalize/ssd_conv4_3";
+  layer_case.type = "Normalize";
+  layer_case.params = {{"across_spatial", "0"},
+                       {"channel_shared", "0"},
+                       {"eps", "1e-10"}};
+  layer_case.inputs = {{1, channels, 38, 38}};
+  layer_case.outputs = {{1, channels, 38, 38}};
+  layer_case.blobs = {{"weights", weights}};
+  layer_case.tolerance = 1e-4f;
+  layer_case.reference = [weights](const std::vector<Blob::Ptr> &inputs,
+                                   float *output) {
+    const float *src = data(inputs[0]);
+    SizeVector dims = inputs[0]->getTensorDesc().getDims();
+    size_t channels = dims[1], spatial = dims[2] * dims[3];
+    for (size_t b = 0; b < dims[0]; ++b) {
+      for (size_t i = 0; i < spatial; ++i) {
+        size_t base = b * channels * spatial + i;
+        double sum = 1e-10;
+        for (size_t c = 0; c < channels; ++c) {
+          sum += src[base + c * spatial] * src[base + c * spatial];
+        }
+        double norm = std::sqrt(sum);
+        for (size_t c = 0; c < channels; ++c) {
+          output[base + c * spatial] =
+              static_cast<float>(src[base + c * spatial] / norm * weights[c]);
+        }
+      }
+    }
+  };
+  return layer_case;
+}
+
+ExtensionBench::LayerCase makeArgMax() {
+  ExtensionBench::LayerCase layer_case;
+  layer_case.name = "ArgMax/segmentation";
+  layer_case.type = "ArgMax";
+  layer_case.params = {{"out_max_val", "0"}, {"top_k", "1"}, {"axis", "1"}};
+  layer_case.inputs = {{1, 21, 128, 128}};
+  layer_case.outputs = {{1, 1, 128, 128}};
+  layer_case.reference = [](const std::vector<Blob::Ptr> &inputs,
+                            float *output) {
+    const float *src = data(inputs[0]);
+    SizeVector dims = inputs[0]->getTensorDesc().getDims();
+    size_t channels = dims[1], spatial = dims[2] * dims[3];
+    for (size_t b = 0; b < dims[0]; ++b) {
+      for (size_t i = 0; i < spatial; ++i) {
+        const float *pixel = src + b * channels * spatial + i;
+        size_t best = 0;
+        for (size_t c = 1; c < channels; ++c) {
+          if (pixel[c * spatial] >= pixel[best * spatial]) {
+            best = c;
+          }
+        }
+        output[b * spatial + i] = static_cast<float>(best);
+      }
+    }
+  };
+  return layer_case;
+}
+
+ExtensionBench::LayerCase makeReorgYolo() {
+  const size_t stride = 2;
+  ExtensionBench::LayerCase layer_case;
+  layer_case.name = "ReorgYolo/yolo_v2";
+  layer_case.type = "ReorgYolo";
+  layer_case.params = {{"stride", std::to_string(stride)}};
+  layer_case.inputs = {{1, 64, 26, 26}};
+  layer_case.outputs = {{1, 256, 13, 13}};
+  // darknet reorg, walked from the source side
+  layer_case.reference = [stride](const std::vector<Blob::Ptr> &inputs,
+                                  float *output) {
+    const float *src = data(inputs[0]);
+    SizeVector dims = inputs[0]->getTensorDesc().getDims();
+    size_t channels = dims[1], height = dims[2], width = dims[3];
+    size_t src_channels = channels / (stride * stride);
+    size_t src_height = height * stride, src_width = width * stride;
+    for (size_t b = 0; b < dims[0]; ++b) {
+      for (size_t c = 0; c < src_channels; ++c) {
+        for (size_t y = 0; y < src_height; ++y) {
+          for (size_t x = 0; x < src_width; ++x) {
+            size_t offset = (y % stride) * stride + x % stride;
+            size_t dst_c = offset * src_channels + c;
+            output[((b * channels + dst_c) * height + y / stride) * width +
+                x / stride] =
+                src[((b * src_channels + c) * src_height + y) * src_width + x];
+          }
+        }
+      }
+    }
+  };
+  return layer_case;
+}
+
+ExtensionBench::LayerCase makeRegionYolo(bool yolo_v3) {
+  const size_t classes = yolo_v3 ? 80 : 20;
+  const size_t coords = 4;
+  const size_t anchors = yolo_v3 ? 3 : 5;
+  ExtensionBench::LayerCase layer_case;
+  layer_case.name = yolo_v3 ? "RegionYolo/yolo_v3" : "RegionYolo/yolo_v2";
+  layer_case.type = "RegionYolo";
+  layer_case.params = {{"classes", std::to_string(classes)},
+                       {"coords", std::to_string(coords)},
+                       {"num", yolo_v3 ? "9" : "5"},
+                       {"do_softmax", yolo_v3 ? "0" : "1"}};
+  if (yolo_v3) {
+    layer_case.params["mask"] = "0,1,2";
+  }
+  SizeVector dims = {1, anchors * (classes + coords + 1), 13, 13};
+  layer_case.inputs = {dims};
+  layer_case.outputs = {dims};
+  layer_case.fill = [](size_t, float *data, size_t size, std::mt19937 *rng) {
+    fillUniform(data, size, -4.f, 4.f, rng);
+  };
+  layer_case.tolerance = 1e-4f;
+  layer_case.reference = [classes, coords, anchors, yolo_v3](
+      const std::vector<Blob::Ptr> &inputs, float *output) {
+    const float *src = data(inputs[0]);
+    SizeVector dims = inputs[0]->getTensorDesc().getDims();
+    size_t spatial = dims[2] * dims[3];
+    size_t entries = classes + coords + 1;
+    std::copy(src, src + count(dims), output);
+    for (size_t b = 0; b < dims[0]; ++b) {
+      for (size_t n = 0; n < anchors; ++n) {
+        size_t base = (b * anchors + n) * entries * spatial;
+        // box center
+        for (size_t i = base; i < base + 2 * spatial; ++i) {
+          output[i] = logistic(src[i]);
+        }
+        // objectness, and the class scores of yolo v3
+        size_t activated = yolo_v3 ? classes + 1 : 1;
+        size_t objectness = base + coords * spatial;
+        for (size_t i = objectness; i < objectness + activated * spatial;
+             ++i) {
+          output[i] = logistic(src[i]);
+        }
+        if (yolo_v3) {
+          continue;
+        }
+        const float *scores = src + objectness + spatial;
+        float *probabilities = output + objectness + spatial;
+        for (size_t i = 0; i < spatial; ++i) {
+          float max = scores[i];
+          for (size_t c = 1; c < classes; ++c) {
+            max = std::max(max, scores[c * spatial + i]);
+          }
+          double sum = 0;
+          for (size_t c = 0; c < classes; ++c) {
+            sum += std::exp(scores[c * spatial + i] - max);
+          }
+          for (size_t c = 0; c < classes; ++c) {
+            probabilities[c * spatial + i] =
+                static_cast<float>(std::exp(scores[c * spatial + i] - max) /
+                    sum);
+          }
+        }
+      }
+    }
+  };
+  return layer_case;
+}
+
+ExtensionBench::LayerCase makeCTCGreedyDecoder() {
+  const size_t sequence_length = 80;
+  ExtensionBench::LayerCase layer_case;
+  layer_case.name = "CTCGreedyDecoder/lprnet";
+  layer_case.type = "CTCGreedyDecoder";
+  layer_case.params = {{"ctc_merge_repeated", "1"}};
+  layer_case.inputs = {{88, 1, 71}, {88, 1}};
+  layer_case.outputs = {{1, 88, 1, 1}};
+  layer_case.fill = [sequence_length](size_t input, float *data, size_t size,
+                                      std::mt19937 *rng) {
+    if (input == 0) {
+      fillUniform(data, size, 0.f, 1.f, rng);
+      return;
+    }
+    for (size_t t = 0; t < size; ++t) {
+      data[t] = t < sequence_length ? 1.f : 0.f;
+    }
+  };
+  layer_case.reference = [](const std::vector<Blob::Ptr> &inputs,
+                            float *output) {
+    const float *probabilities = data(inputs[0]);
+    const float *indicators = data(inputs[1]);
+    SizeVector dims = inputs[0]->getTensorDesc().getDims();
+    size_t steps = dims[0], batch = dims[1], classes = dims[2];
+    std::fill(output, output + steps * batch, -1.f);
+    for (size_t n = 0; n < batch; ++n) {
+      float *sequence = output + n * steps;
+      size_t previous = classes;
+      for (size_t t = 0; t < steps; ++t) {
+        if (t > 0 && indicators[t * batch + n] == 0) {
+          break;
+        }
+        const float *step = probabilities + (t * batch + n) * classes;
+        size_t best =
+            static_cast<size_t>(std::max_element(step, step + classes) - step);
+        // the last class is the blank
+        if (best != classes - 1 && best != previous) {
+          *sequence++ = static_cast<float>(best);
+        }
+        previous = best;
+      }
+    }
+  };
+  return layer_case;
+}
+
+ExtensionBench::LayerCase makeResample(const std::string &mode,
+                                       size_t channels, size_t size,
+                                       size_t factor) {
+  ExtensionBench::LayerCase layer_case;
+  layer_case.name = "Resample/" + mode + "_x" + std::to_string(factor);
+  layer_case.type = "Resample";
+  layer_case.params = {{"type", "caffe.ResampleParameter." +
+      std::string(mode == "nearest" ? "NEAREST" : "LINEAR")},
+                       {"antialias", "0"}};
+  layer_case.inputs = {{1, channels, size, size}};
+  layer_case.outputs = {{1, channels, size * factor, size * factor}};
+  if (mode != "nearest") {
+    // triangle weights around the pixel centers, normalized by their sum
+    // where the image border drops some of them
+    layer_case.reference = [factor](const std::vector<Blob::Ptr> &inputs,
+                                    float *output) {
+      const float *src = data(inputs[0]);
+      SizeVector dims = inputs[0]->getTensorDesc().getDims();
+      int height = static_cast<int>(dims[2]);
+      int width = static_cast<int>(dims[3]);
+      double scale = 1.0 / factor;
+      for (size_t plane = 0; plane < dims[0] * dims[1]; ++plane) {
+        const float *pixels = src + plane * height * width;
+        for (size_t y = 0; y < height * factor; ++y) {
+          double iy = y * scale + scale / 2 - 0.5;
+          for (size_t x = 0; x < width * factor; ++x) {
+            double ix = x * scale + scale / 2 - 0.5;
+            double sum = 0, weights = 0;
+            for (int sy = static_cast<int>(std::floor(iy));
+                 sy <= static_cast<int>(std::floor(iy)) + 1; ++sy) {
+              for (int sx = static_cast<int>(std::floor(ix));
+                   sx <= static_cast<int>(std::floor(ix)) + 1; ++sx) {
+                if (sy < 0 || sx < 0 || sy >= height || sx >= width) {
+                  continue;
+                }
+                double weight = (1 - std::fabs(iy - sy)) *
+                    (1 - std::fabs(ix - sx));
+                sum += weight * pixels[sy * width + sx];
+                weights += weight;
+              }
+            }
+            *output++ = weights ? static_cast<float>(sum / weights) : 0.f;
+          }
+        }
+      }
+    };
+    return layer_case;
+  }
+  layer_case.reference = [factor](const std::vector<Blob::Ptr> &inputs,
+                                  float *output) {
+    const float *src = data(inputs[0]);
+    SizeVector dims = inputs[0]->getTensorDesc().getDims();
+    size_t height = dims[2], width = dims[3];
+    for (size_t plane = 0; plane < dims[0] * dims[1]; ++plane) {
+      for (size_t y = 0; y < height * factor; ++y) {
+        for (size_t x = 0; x < width * factor; ++x) {
+          *output++ = src[(plane * height + y / factor) * width + x / factor];
+        }
+      }
+    }
+  };
+  return layer_case;
+}
+
+ExtensionBench::LayerCase makeInterp() {
+  ExtensionBench::LayerCase layer_case;
+  layer_case.name = "Interp/pspnet_x2";
+  layer_case.type = "Interp";
+  layer_case.params = {{"pad_beg", "0"}, {"pad_end", "0"}};
+  // channels are a multiple of the 16 channel blocks of the layer
+  layer_case.inputs = {{1, 256, 32, 32}};
+  layer_case.outputs = {{1, 256, 64, 64}};
+  layer_case.tolerance = 1e-4f;
+  // bilinear with the corners aligned, on the planar copy of the blobs
+  layer_case.reference = [](const std::vector<Blob::Ptr> &inputs,
+                            float *output) {
+    const size_t out_height = 64, out_width = 64;
+    const float *src = data(inputs[0]);
+    SizeVector dims = inputs[0]->getTensorDesc().getDims();
+    size_t height = dims[2], width = dims[3];
+    double scale_y = static_cast<double>(height - 1) / (out_height - 1);
+    double scale_x = static_cast<double>(width - 1) / (out_width - 1);
+    for (size_t plane = 0; plane < dims[0] * dims[1]; ++plane) {
+      const float *pixels = src + plane * height * width;
+      for (size_t y = 0; y < out_height; ++y) {
+        double iy = y * scale_y;
+        size_t y0 = static_cast<size_t>(iy);
+        size_t y1 = std::min(y0 + 1, height - 1);
+        double dy = iy - y0;
+        for (size_t x = 0; x < out_width; ++x) {
+          double ix = x * scale_x;
+          size_t x0 = static_cast<size_t>(ix);
+          size_t x1 = std::min(x0 + 1, width - 1);
+          double dx = ix - x0;
+          double top = (1 - dx) * pixels[y0 * width + x0] +
+              dx * pixels[y0 * width + x1];
+          double bottom = (1 - dx) * pixels[y1 * width + x0] +
+              dx * pixels[y1 * width + x1];
+          *output++ = static_cast<float>((1 - dy) * top + dy * bottom);
+        }
+      }
+    }
+  };
+  return layer_case;
+}
+
+ExtensionBench::LayerCase makePSROIPooling() {
+  const size_t output_dim = 21, group_size = 7;
+  const float spatial_scale = 0.0625f, height = 600, width = 1000;
+  ExtensionBench::LayerCase layer_case;
+  layer_case.name = "PSROIPooling/rfcn";
+  layer_case.type = "PSROIPooling";
+  layer_case.params = {{"output_dim", std::to_string(output_dim)},
+                       {"group_size", std::to_string(group_size)},
+                       {"spatial_scale", "0.0625"}};
+  layer_case.inputs = {{1, output_dim * group_size * group_size, 38, 63},
+                       {300, 5}};
+  layer_case.outputs = {{300, output_dim, group_size, group_size}};
+  layer_case.fill = [height, width](size_t input, float *data, size_t size,
+                                    std::mt19937 *rng) {
+    if (input == 0) {
+      fillUniform(data, size, -1.f, 1.f, rng);
+    } else {
+      fillRois(data, size, height, width, rng);
+    }
+  };
+  layer_case.tolerance = 1e-4f;
+  layer_case.reference = [output_dim, group_size, spatial_scale](
+      const std::vector<Blob::Ptr> &inputs, float *output) {
+    const float *src = data(inputs[0]);
+    const float *rois = data(inputs[1]);
+    SizeVector dims = inputs[0]->getTensorDesc().getDims();
+    int channels = static_cast<int>(dims[1]);
+    int height = static_cast<int>(dims[2]), width = static_cast<int>(dims[3]);
+    size_t num_rois = inputs[1]->getTensorDesc().getDims()[0];
+    size_t bins = output_dim * group_size * group_size;
+    std::fill(output, output + num_rois * bins, 0.f);
+    for (size_t n = 0; n < num_rois; ++n) {
+      const float *roi = rois + n * 5;
+      if (roi[0] == -1) {
+        break;
+      }
+      float x0 = std::round(roi[1]) * spatial_scale;
+      float y0 = std::round(roi[2]) * spatial_scale;
+      float bin_w = std::max((std::round(roi[3]) + 1) * spatial_scale - x0,
+                             0.1f) / group_size;
+      float bin_h = std::max((std::round(roi[4]) + 1) * spatial_scale - y0,
+                             0.1f) / group_size;
+      for (size_t c = 0; c < output_dim; ++c) {
+        for (size_t h = 0; h < group_size; ++h) {
+          for (size_t w = 0; w < group_size; ++w) {
+            int y_start = std::min(std::max(
+                static_cast<int>(std::floor(h * bin_h + y0)), 0), height);
+            int y_end = std::min(std::max(
+                static_cast<int>(std::ceil((h + 1) * bin_h + y0)), 0), height);
+            int x_start = std::min(std::max(
+                static_cast<int>(std::floor(w * bin_w + x0)), 0), width);
+            int x_end = std::min(std::max(
+                static_cast<int>(std::ceil((w + 1) * bin_w + x0)), 0), width);
+            if (y_end <= y_start || x_end <= x_start) {
+              continue;
+            }
+            size_t channel = (c * group_size + h) * group_size + w;
+            const float *plane = src + (static_cast<size_t>(roi[0]) *
+                channels + channel) * height * width;
+            double sum = 0;
+            for (int y = y_start; y < y_end; ++y) {
+              for (int x = x_start; x < x_end; ++x) {
+                sum += plane[y * width + x];
+              }
+            }
+            output[((n * output_dim + c) * group_size + h) * group_size + w] =
+                static_cast<float>(sum / ((y_end - y_start) *
+                    (x_end - x_start)));
+          }
+        }
+      }
+    }
+  };
+  return layer_case;
+}
+
+ExtensionBench::LayerCase makePriorBox() {
+  ExtensionBench::LayerCase layer_case;
+  layer_case.name = "PriorBox/ssd_conv4_3";
+  layer_case.type = "PriorBox";
+  layer_case.params = {{"min_size", "30"}, {"max_size", "60"},
+                       {"aspect_ratio", "2"}, {"flip", "1"}, {"clip", "0"},
+                       {"step", "8"}, {"offset", "0.5"},
+                       {"variance", "0.1,0.1,0.2,0.2"}};
+  layer_case.inputs = {{1, 512, 38, 38}, {1, 3, 300, 300}};
+  // 4 priors of 4 coordinates per location
+  layer_case.outputs = {{1, 2, 38 * 38 * 4 * 4}};
+  // squares of min_size and sqrt(min_size * max_size), then the boxes of
+  // min_size area with the aspect ratios 2 and 1/2
+  layer_case.reference = [](const std::vector<Blob::Ptr> &inputs,
+                            float *output) {
+    const float min_size = 30, max_size = 60, step = 8, offset = 0.5f;
+    const float variance[] = {0.1f, 0.1f, 0.2f, 0.2f};
+    SizeVector dims = inputs[0]->getTensorDesc().getDims();
+    SizeVector image = inputs[1]->getTensorDesc().getDims();
+    float image_height = image[2], image_width = image[3];
+    std::vector<std::pair<float, float>> sizes = {
+        {min_size, min_size},
+        {std::sqrt(min_size * max_size), std::sqrt(min_size * max_size)},
+        {min_size * std::sqrt(2.f), min_size / std::sqrt(2.f)},
+        {min_size / std::sqrt(2.f), min_size * std::sqrt(2.f)}};
+    size_t channel = dims[2] * dims[3] * sizes.size() * 4;
+    float *boxes = output;
+    for (size_t h = 0; h < dims[2]; ++h) {
+      for (size_t w = 0; w < dims[3]; ++w) {
+        float center_x = (w + offset) * step, center_y = (h + offset) * step;
+        for (auto &size : sizes) {
+          *boxes++ = (center_x - size.first / 2) / image_width;
+          *boxes++ = (center_y - size.second / 2) / image_height;
+          *boxes++ = (center_x + size.first / 2) / image_width;
+          *boxes++ = (center_y + size.second / 2) / image_height;
+        }
+      }
+    }
+    for (size_t i = 0; i < channel; ++i) {
+      output[channel + i] = variance[i % 4];
+    }
+  };
+  return layer_case;
+}
+
+ExtensionBench::LayerCase makePriorBoxClustered() {
+  ExtensionBench::LayerCase layer_case;
+  layer_case.name = "PriorBoxClustered/ssd_mobilenet";
+  layer_case.type = "PriorBoxClustered";
+  layer_case.params = {{"width", "9.4,25.1,14.7,34.7,143.0"},
+                       {"height", "15.0,39.6,25.5,63.2,227.5"},
+                       {"clip", "0"}, {"step", "16"}, {"offset", "0.5"},
+                       {"variance", "0.1,0.1,0.2,0.2"}};
+  layer_case.inputs = {{1, 128, 19, 19}, {1, 3, 300, 300}};
+  layer_case.outputs = {{1, 2, 19 * 19 * 5 * 4}};
+  layer_case.reference = [](const std::vector<Blob::Ptr> &inputs,
+                            float *output) {
+    const float widths[] = {9.4f, 25.1f, 14.7f, 34.7f, 143.0f};
+    const float heights[] = {15.0f, 39.6f, 25.5f, 63.2f, 227.5f};
+    const float step = 16, offset = 0.5f;
+    const float variance[] = {0.1f, 0.1f, 0.2f, 0.2f};
+    SizeVector dims = inputs[0]->getTensorDesc().getDims();
+    SizeVector image = inputs[1]->getTensorDesc().getDims();
+    float image_height = image[2], image_width = image[3];
+    size_t channel = dims[2] * dims[3] * 5 * 4;
+    float *boxes = output;
+    for (size_t h = 0; h < dims[2]; ++h) {
+      for (size_t w = 0; w < dims[3]; ++w) {
+        float center_x = (w + offset) * step, center_y = (h + offset) * step;
+        for (size_t s = 0; s < 5; ++s) {
+          *boxes++ = (center_x - widths[s] / 2) / image_width;
+          *boxes++ = (center_y - heights[s] / 2) / image_height;
+          *boxes++ = (center_x + widths[s] / 2) / image_width;
+          *boxes++ = (center_y + heights[s] / 2) / image_height;
+        }
+      }
+    }
+    for (size_t i = 0; i < channel; ++i) {
+      output[channel + i] = variance[i % 4];
+    }
+  };
+  return layer_case;
+}
+
+/**
+ * @brief Decode CENTER_SIZE boxes like the scalar path of DetectionOutput,
+ * with the variances in the second half of the priors.
+ */
+void decodeBoxes(const float *loc, const float *priors, size_t num_priors,
+                 float *boxes, float *sizes) {
+  const float *variances = priors + num_priors * 4;
+  for (size_t p = 0; p < num_priors; ++p) {
+    const float *prior = priors + p * 4;
+    const float *variance = variances + p * 4;
+    float prior_width = prior[2] - prior[0];
+    float prior_height = prior[3] - prior[1];
+    float center_x = variance[0] * loc[p * 4] * prior_width +
+        (prior[0] + prior[2]) / 2.0f;
+    float center_y = variance[1] * loc[p * 4 + 1] * prior_height +
+        (prior[1] + prior[3]) / 2.0f;
+    float width = std::exp(variance[2] * loc[p * 4 + 2]) * prior_width;
+    float height = std::exp(variance[3] * loc[p * 4 + 3]) * prior_height;
+    float *box = boxes + p * 4;
+    box[0] = center_x - width / 2.0f;
+    box[1] = center_y - height / 2.0f;
+    box[2] = center_x + width / 2.0f;
+    box[3] = center_y + height / 2.0f;
+    sizes[p] = (box[2] - box[0]) * (box[3] - box[1]);
+  }
+}
+
+float jaccardOverlap(const float *a, float size_a, const float *b,
+                     float size_b) {
+  float width = std::min(a[2], b[2]) - std::max(a[0], b[0]);
+  float height = std::min(a[3], b[3]) - std::max(a[1], b[1]);
+  if (width <= 0 || height <= 0) {
+    return 0.f;
+  }
+  float intersection = width * height;
+  return intersection / (size_a + size_b - intersection);
+}
+
+ExtensionBench::LayerCase makeDetectionOutput(const std::string &strategy) {
+  const size_t priors = 8732, classes = 21;
+  ExtensionBench::LayerCase layer_case;
+  layer_case.name = "DetectionOutput/ssd300_" + strategy;
+  layer_case.type = "DetectionOutput";
+  layer_case.params = {{"num_classes", std::to_string(classes)},
+                       {"background_label_id", "0"},
+                       {"top_k", "400"},
+                       {"keep_top_k", "200"},
+                       {"nms_threshold", "0.45"},
+                       {"confidence_threshold", "0.01"},
+                       {"share_location", "1"},
+                       {"variance_encoded_in_target", "0"},
+                       {"code_type", "caffe.PriorBoxParameter.CENTER_SIZE"}};
+  layer_case.params["nms_strategy"] = strategy;
+  layer_case.inputs = {{1, priors * 4}, {1, priors * classes},
+                       {1, 2, priors * 4}};
+  layer_case.outputs = {{1, 1, 200, 7}};
+  layer_case.fill = [](size_t input, float *data, size_t size,
+                       std::mt19937 *rng) {
+    if (input == 0) {
+      fillUniform(data, size, -0.5f, 0.5f, rng);
+    } else if (input == 1) {
+      // mostly background like a softmax output
+      fillUniform(data, size, 0.f, 1.f, rng);
+      for (size_t i = 0; i < size; ++i) {
+        data[i] = std::pow(data[i], 8.f);
+      }
+    } else {
+      std::uniform_real_distribution<float> center(0.f, 1.f);
+      std::uniform_real_distribution<float> side(0.05f, 0.5f);
+      for (size_t i = 0; i < size / 2; i += 4) {
+        float x = center(*rng), y = center(*rng);
+        float w = side(*rng), h = side(*rng);
+        data[i] = x - w / 2;
+        data[i + 1] = y - h / 2;
+        data[i + 2] = x + w / 2;
+        data[i + 3] = y + h / 2;
+      }
+      const float variance[] = {0.1f, 0.1f, 0.2f, 0.2f};
+      for (size_t i = size / 2; i < size; ++i) {
+        data[i] = variance[i % 4];
+      }
+    }
+  };
+  // the fast NMS must keep exactly the boxes of the greedy one, the matrix
+  // NMS decays the scores instead of dropping boxes
+  bool matrix = strategy == "matrix";
+  layer_case.reference = [classes, matrix](
+      const std::vector<Blob::Ptr> &inputs, float *output) {
+    const size_t top_k = 400, keep_top_k = 200;
+    const float nms_threshold = 0.45f, confidence_threshold = 0.01f;
+    const float *conf = data(inputs[1]);
+    size_t priors = inputs[0]->size() / 4;
+    std::vector<float> boxes(priors * 4), sizes(priors);
+    decodeBoxes(data(inputs[0]), data(inputs[2]), priors, boxes.data(),
+                sizes.data());
+    auto overlap = [&boxes, &sizes](size_t a, size_t b) {
+      return jaccardOverlap(&boxes[a * 4], sizes[a], &boxes[b * 4], sizes[b]);
+    };
+
+    struct Detection {
+      float score;
+      size_t label;
+      size_t prior;
+    };
+    std::vector<Detection> detections;
+    for (size_t c = 1; c < classes; ++c) {
+      auto score = [conf, classes, c](size_t p) {
+        return conf[p * classes + c];
+      };
+      std::vector<size_t> candidates;
+      for (size_t p = 0; p < priors; ++p) {
+        if (score(p) > confidence_threshold) {
+          candidates.push_back(p);
+        }
+      }
+      std::sort(candidates.begin(), candidates.end(),
+                [&score](size_t a, size_t b) {
+                  return score(a) > score(b) ||
+                      (score(a) == score(b) && a < b);
+                });
+      candidates.resize(std::min(candidates.size(), top_k));
+
+      if (!matrix) {
+        std::vector<size_t> kept;
+        for (size_t p : candidates) {
+          if (std::none_of(kept.begin(), kept.end(), [&](size_t k) {
+                return overlap(p, k) > nms_threshold;
+              })) {
+            kept.push_back(p);
+            detections.push_back({score(p), c, p});
+          }
+        }
+        continue;
+      }
+      // every box is decayed by its overlap with each better box, divided by
+      // what that box keeps of its own score (the linear kernel)
+      std::vector<float> max_overlaps(candidates.size());
+      for (size_t i = 0; i < candidates.size(); ++i) {
+        float max_overlap = 0.f, decay = 1.f;
+        for (size_t j = 0; j < i; ++j) {
+          float box_overlap = overlap(candidates[i], candidates[j]);
+          max_overlap = std::max(max_overlap, box_overlap);
+          decay = std::min(decay, (1.f - box_overlap) /
+              std::max(1.f - max_overlaps[j], FLT_EPSILON));
+        }
+        max_overlaps[i] = max_overlap;
+        float decayed = score(candidates[i]) * decay;
+        if (decayed > confidence_threshold) {
+          detections.push_back({decayed, c, candidates[i]});
+        }
+      }
+    }
+
+    // the best keep_top_k detections, grouped by class
+    std::sort(detections.begin(), detections.end(),
+              [](const Detection &a, const Detection &b) {
+                if (a.score != b.score) {
+                  return a.score > b.score;
+                }
+                return a.label != b.label ? a.label < b.label :
+                       a.prior < b.prior;
+              });
+    detections.resize(std::min(detections.size(), keep_top_k));
+    std::stable_sort(detections.begin(), detections.end(),
+                     [](const Detection &a, const Detection &b) {
+                       return a.label < b.label;
+                     });
+
+    std::fill(output, output + keep_top_k * 7, 0.f);
+    for (size_t i = 0; i < detections.size(); ++i) {
+      float *row = output + i * 7;
+      row[1] = static_cast<float>(detections[i].label);
+      row[2] = detections[i].score;
+      std::copy(&boxes[detections[i].prior * 4],
+                &boxes[detections[i].prior * 4] + 4, row + 3);
+    }
+    if (detections.size() < keep_top_k) {
+      output[detections.size() * 7] = -1;
+    }
+  };
+  return layer_case;
+}
+
+/**
+ * @brief Caffe anchors of Proposal and SimplerNMS as x0, y0, x1, y1: a 16x16
+ * base box reshaped to the ratios 0.5, 1 and 2, each scaled by 8, 16 and 32.
+ */
+std::vector<float> makeAnchors() {
+  const float ratios[] = {0.5f, 1.f, 2.f};
+  const float scales[] = {8.f, 16.f, 32.f};
+  const float center = 7.5f;
+  std::vector<float> anchors;
+  for (float ratio : ratios) {
+    float width = std::round(std::sqrt(16.f * 16.f / ratio));
+    float height = std::round(width * ratio);
+    for (float scale : scales) {
+      float half_width = 0.5f * (width * scale - 1);
+      float half_height = 0.5f * (height * scale - 1);
+      anchors.insert(anchors.end(),
+                     {center - half_width, center - half_height,
+                      center + half_width, center + half_height});
+    }
+  }
+  return anchors;
+}
+
+/**
+ * @brief Overlap of two boxes with the inclusive pixel coordinates of Caffe.
+ */
+float pixelOverlap(const float *a, const float *b) {
+  if (a[0] > b[2] || a[1] > b[3] || b[0] > a[2] || b[1] > a[3]) {
+    return 0.f;
+  }
+  float width = std::max(0.f, std::min(a[2], b[2]) - std::max(a[0], b[0]) + 1);
+  float height =
+      std::max(0.f, std::min(a[3], b[3]) - std::max(a[1], b[1]) + 1);
+  float intersection = width * height;
+  float area_a = (a[2] - a[0] + 1) * (a[3] - a[1] + 1);
+  float area_b = (b[2] - b[0] + 1) * (b[3] - b[1] + 1);
+  return intersection / (area_a + area_b - intersection);
+}
+
+/**
+ * @brief Faster R-CNN region proposals on a 600x800 image, shared by the
+ * Proposal and SimplerNMS cases.
+ */
+ExtensionBench::LayerCase makeRegionProposal(const std::string &type,
+                                             size_t post_nms_topn) {
+  ExtensionBench::LayerCase layer_case;
+  layer_case.name = type + "/faster_rcnn";
+  layer_case.type = type;
+  layer_case.inputs = {{1, 18, 38, 50}, {1, 36, 38, 50}, {1, 3}};
+  layer_case.outputs = {{post_nms_topn, 5}};
+  layer_case.fill = [](size_t input, float *data, size_t size,
+                       std::mt19937 *rng) {
+    if (input == 0) {
+      // distinct scores, so that the order of the proposals is defined
+      std::vector<size_t> order(size);
+      std::iota(order.begin(), order.end(), 0);
+      std::shuffle(order.begin(), order.end(), *rng);
+      for (size_t i = 0; i < size; ++i) {
+        data[i] = (order[i] + 0.5f) / size;
+      }
+    } else if (input == 1) {
+      fillUniform(data, size, -0.2f, 0.2f, rng);
+    } else {
+      fillImageInfo(data, size, 600, 800);
+    }
+  };
+  return layer_case;
+}
+
+ExtensionBench::LayerCase makeProposal() {
+  auto layer_case = makeRegionProposal("Proposal", 300);
+  layer_case.params = {{"feat_stride", "16"}, {"base_size", "16"},
+                       {"min_size", "16"}, {"pre_nms_topn", "6000"},
+                       {"post_nms_topn", "300"}, {"nms_thresh", "0.7"},
+                       {"ratio", "0.5,1,2"}, {"scale", "8,16,32"}};
+  // every anchor at every cell, too small boxes scored 0, then greedy NMS
+  // over the pre_nms_topn best ones
+  layer_case.reference = [](const std::vector<Blob::Ptr> &inputs,
+                            float *output) {
+    const size_t pre_nms_topn = 6000, post_nms_topn = 300;
+    const float stride = 16, min_size = 16, nms_threshold = 0.7f;
+    std::vector<float> anchors = makeAnchors();
+    size_t num_anchors = anchors.size() / 4;
+    SizeVector dims = inputs[0]->getTensorDesc().getDims();
+    size_t height = dims[2], width = dims[3], spatial = height * width;
+    // the second half of the scores are the foreground ones
+    const float *scores = data(inputs[0]) + num_anchors * spatial;
+    const float *deltas = data(inputs[1]);
+    const float *image = data(inputs[2]);
+    float max_x = image[1] - 1, max_y = image[0] - 1;
+    float min_box = min_size * image[2];
+
+    struct Proposal {
+      float box[4];
+      float score;
+    };
+    std::vector<Proposal> proposals;
+    for (size_t h = 0; h < height; ++h) {
+      for (size_t w = 0; w < width; ++w) {
+        for (size_t a = 0; a < num_anchors; ++a) {
+          const float *anchor = &anchors[a * 4];
+          const float *delta = deltas + a * 4 * spatial + h * width + w;
+          float x0 = w * stride + anchor[0], y0 = h * stride + anchor[1];
+          float box_width = w * stride + anchor[2] - x0 + 1;
+          float box_height = h * stride + anchor[3] - y0 + 1;
+          float center_x =
+              delta[0] * box_width + (x0 + 0.5f * box_width);
+          float center_y =
+              delta[spatial] * box_height + (y0 + 0.5f * box_height);
+          float half_width = 0.5f * std::exp(delta[2 * spatial]) * box_width;
+          float half_height =
+              0.5f * std::exp(delta[3 * spatial]) * box_height;
+          Proposal proposal = {
+              {std::max(0.f, std::min(center_x - half_width, max_x)),
+               std::max(0.f, std::min(center_y - half_height, max_y)),
+               std::max(0.f, std::min(center_x + half_width, max_x)),
+               std::max(0.f, std::min(center_y + half_height, max_y))},
+              scores[a * spatial + h * width + w]};
+          if (proposal.box[2] - proposal.box[0] + 1 < min_box ||
+              proposal.box[3] - proposal.box[1] + 1 < min_box) {
+            proposal.score = 0;
+          }
+          proposals.push_back(proposal);
+        }
+      }
+    }
+    std::stable_sort(proposals.begin(), proposals.end(),
+                     [](const Proposal &a, const Proposal &b) {
+                       return a.score > b.score;
+                     });
+    proposals.resize(std::min(proposals.size(), pre_nms_topn));
+
+    std::fill(output, output + post_nms_topn * 5, 0.f);
+    std::vector<bool> suppressed(proposals.size(), false);
+    size_t rois = 0;
+    for (size_t i = 0; i < proposals.size() && rois < post_nms_topn; ++i) {
+      if (suppressed[i]) {
+        continue;
+      }
+      std::copy(proposals[i].box, proposals[i].box + 4,
+                output + rois++ * 5 + 1);
+      for (size_t j = i + 1; j < proposals.size(); ++j) {
+        if (pixelOverlap(proposals[i].box, proposals[j].box) >
+            nms_threshold) {
+          suppressed[j] = true;
+        }
+      }
+    }
+    if (rois < post_nms_topn) {
+      output[rois * 5] = -1;
+    }
+  };
+  return layer_case;
+}
+
+ExtensionBench::LayerCase makeSimplerNMS() {
+  auto layer_case = makeRegionProposal("SimplerNMS", 150);
+  layer_case.params = {{"min_bbox_size", "16"}, {"feat_stride", "16"},
+                       {"pre_nms_topn", "6000"}, {"post_nms_topn", "150"},
+                       {"iou_threshold", "0.7"}, {"scale", "8,16,32"}};
+  // like Proposal, but too small boxes are dropped before the pre_nms_topn
+  // best ones are taken, and later boxes first among equal scores
+  layer_case.reference = [](const std::vector<Blob::Ptr> &inputs,
+                            float *output) {
+    const size_t pre_nms_topn = 6000, post_nms_topn = 150;
+    const float stride = 16, min_size = 16, iou_threshold = 0.7f;
+    std::vector<float> anchors = makeAnchors();
+    size_t num_anchors = anchors.size() / 4;
+    SizeVector dims = inputs[0]->getTensorDesc().getDims();
+    size_t height = dims[2], width = dims[3], spatial = height * width;
+    const float *scores = data(inputs[0]) + num_anchors * spatial;
+    const float *deltas = data(inputs[1]);
+    const float *image = data(inputs[2]);
+    float max_x = image[1] - 1, max_y = image[0] - 1;
+    float min_box = min_size * image[2];
+
+    struct Proposal {
+      float box[4];
+      float score;
+      size_t order;
+    };
+    std::vector<Proposal> proposals;
+    for (size_t h = 0; h < height; ++h) {
+      for (size_t w = 0; w < width; ++w) {
+        for (size_t a = 0; a < num_anchors; ++a) {
+          const float *anchor = &anchors[a * 4];
+          const float *delta = deltas + a * 4 * spatial + h * width + w;
+          float anchor_width = anchor[2] - anchor[0] + 1;
+          float anchor_height = anchor[3] - anchor[1] + 1;
+          float center_x = delta[0] * anchor_width +
+              (anchor[0] + 0.5f * anchor_width) + w * stride;
+          float center_y = delta[spatial] * anchor_height +
+              (anchor[1] + 0.5f * anchor_height) + h * stride;
+          float half_width =
+              std::exp(delta[2 * spatial]) * anchor_width * 0.5f;
+          float half_height =
+              std::exp(delta[3 * spatial]) * anchor_height * 0.5f;
+          Proposal proposal = {
+              {std::max(0.f, std::min(center_x - half_width, max_x)),
+               std::max(0.f, std::min(center_y - half_height, max_y)),
+               std::max(0.f, std::min(center_x + half_width, max_x)),
+               std::max(0.f, std::min(center_y + half_height, max_y))},
+              scores[a * spatial + h * width + w], proposals.size()};
+          // sizes are whole pixels
+          if (static_cast<int>(proposal.box[2] - proposal.box[0] + 1) >=
+                  min_box &&
+              static_cast<int>(proposal.box[3] - proposal.box[1] + 1) >=
+                  min_box) {
+            proposals.push_back(proposal);
+          }
+        }
+      }
+    }
+    std::sort(proposals.begin(), proposals.end(),
+              [](const Proposal &a, const Proposal &b) {
+                return a.score > b.score ||
+                    (a.score == b.score && a.order > b.order);
+              });
+    proposals.resize(std::min(proposals.size(), pre_nms_topn));
+
+    // overlapping when the intersection is above the threshold times the
+    // union, with the inclusive pixel areas
+    auto area = [](const float *box) {
+      return std::max(0.f, box[3] - box[1] + 1) *
+          std::max(0.f, box[2] - box[0] + 1);
+    };
+    auto overlaps = [&area, iou_threshold](const float *a, const float *b) {
+      const float intersection[] = {
+          std::max(a[0], b[0]), std::max(a[1], b[1]),
+          std::min(a[2], b[2]), std::min(a[3], b[3])};
+      float intersection_area = area(intersection);
+      return intersection_area >
+          iou_threshold * (area(b) + area(a) - intersection_area);
+    };
+
+    std::fill(output, output + post_nms_topn * 5, 0.f);
+    std::vector<const float *> kept;
+    for (auto &proposal : proposals) {
+      if (kept.size() == post_nms_topn) {
+        break;
+      }
+      if (proposal.score > 0 &&
+          std::none_of(kept.begin(), kept.end(), [&](const float *box) {
+            return overlaps(proposal.box, box);
+          })) {
+        std::copy(proposal.box, proposal.box + 4,
+                  output + kept.size() * 5 + 1);
+        kept.push_back(proposal.box);
+      }
+    }
+  };
+  return layer_case;
+}
+
+ExtensionBench::LayerCase makeSpatialTransformer() {
+  ExtensionBench::LayerCase layer_case;
+  layer_case.name = "SpatialTransformer/lprnet";
+  layer_case.type = "SpatialTransformer";
+  // the layer samples 24x94 license plate images only
+  layer_case.inputs = {{1, 3, 24, 94}, {1, 6}};
+  layer_case.outputs = {{1, 3, 24, 94}};
+  layer_case.fill = [](size_t input, float *data, size_t size,
+                       std::mt19937 *rng) {
+    if (input == 0) {
+      fillUniform(data, size, -1.f, 1.f, rng);
+      return;
+    }
+    // a small affine perturbation of the identity
+    fillUniform(data, size, -0.1f, 0.1f, rng);
+    for (size_t i = 0; i + 6 <= size; i += 6) {
+      data[i] += 1.f;
+      data[i + 4] += 1.f;
+    }
+  };
+  layer_case.tolerance = 1e-4f;
+  // theta maps the (row, column, 1) grid of the output over [-1, 1] to the
+  // input, which is sampled bilinearly with zeros outside
+  layer_case.reference = [](const std::vector<Blob::Ptr> &inputs,
+                            float *output) {
+    const float *src = data(inputs[0]);
+    SizeVector dims = inputs[0]->getTensorDesc().getDims();
+    int height = static_cast<int>(dims[2]), width = static_cast<int>(dims[3]);
+    for (size_t n = 0; n < dims[0]; ++n) {
+      const float *theta = data(inputs[1]) + n * 6;
+      for (size_t c = 0; c < dims[1]; ++c) {
+        const float *pixels = src + (n * dims[1] + c) * height * width;
+        for (int row = 0; row < height; ++row) {
+          for (int column = 0; column < width; ++column) {
+            double grid_row = static_cast<double>(row) / height * 2 - 1;
+            double grid_column = static_cast<double>(column) / width * 2 - 1;
+            double y = (theta[0] * grid_row + theta[1] * grid_column +
+                theta[2] + 1) / 2 * height;
+            double x = (theta[3] * grid_row + theta[4] * grid_column +
+                theta[5] + 1) / 2 * width;
+            double sum = 0;
+            for (int sy = static_cast<int>(std::floor(y));
+                 sy <= static_cast<int>(std::floor(y)) + 1; ++sy) {
+              for (int sx = static_cast<int>(std::floor(x));
+                   sx <= static_cast<int>(std::floor(x)) + 1; ++sx) {
+                if (sy >= 0 && sy < height && sx >= 0 && sx < width) {
+                  sum += (1 - std::fabs(y - sy)) * (1 - std::fabs(x - sx)) *
+                      pixels[sy * width + sx];
+                }
+              }
+            }
+            *output++ = static_cast<float>(sum);
+          }
+        }
+      }
+    }
+  };
+  return layer_case;
+}
+
+ExtensionBench::LayerCase makePowerFile() {
+  ExtensionBench::LayerCase layer_case;
+  layer_case.name = "PowerFile/shift";
+  layer_case.type = "PowerFile";
+  layer_case.inputs = {{1, 6, 128, 128}};
+  layer_case.outputs = {{1, 6, 128, 128}};
+  // the shift is built into the layer until it is read from a file
+  layer_case.reference = [](const std::vector<Blob::Ptr> &inputs,
+                            float *output) {
+    const float shift[] = {1, 0, 0, 0, 1, 0};
+    const float *src = data(inputs[0]);
+    for (size_t i = 0; i < inputs[0]->size(); ++i) {
+      output[i] = src[i] + shift[i % 6];
+    }
+  };
+  return layer_case;
+}
+}  // namespace
+
+std::vector<ExtensionBench::LayerCase> ExtensionBench::getLayerCases() {
+  return {
+      makeArgMax(),
+      makeCTCGreedyDecoder(),
+      makeDetectionOutput("greedy"),
+      makeDetectionOutput("fast"),
+      makeDetectionOutput("matrix"),
+      makeGRN(),
+      makeInterp(),
+      makeMVN(false, false),
+      makeMVN(true, false),
+      makeMVN(false, true),
+      makeMVN(true, true),
+      makeNormalize(),
+      makePowerFile(),
+      makePriorBox(),
+      makePriorBoxClustered(),
+      makeProposal(),
+      makePSROIPooling(),
+      makeRegionYolo(false),
+      makeRegionYolo(true),
+      makeReorgYolo(),
+      makeResample("nearest", 64, 80, 2),
+      makeResample("nearest", 32, 40, 4),
+      makeResample("linear", 64, 80, 2),
+      makeSimplerNMS(),
+      makeSpatialTransformer(),
+  };
+}
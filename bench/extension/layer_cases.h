@@ -0,0 +1,70 @@
+/**
+ * @brief A header file with declaration for the cpu_extension layer cases
+ * @file layer_cases.h
+ */
+#ifndef DYNAMIC_VINO_BENCH_LAYER_CASES_H
+#define DYNAMIC_VINO_BENCH_LAYER_CASES_H
+
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "inference_engine.hpp"
+
+namespace ExtensionBench {
+/**
+ * @brief Fill the data of one input of a layer case.
+ * @param[in] input Index of the input.
+ * @param[in] data Buffer of the input blob.
+ * @param[in] size Number of floats in the buffer.
+ * @param[in] rng Random generator seeded once per case.
+ */
+using FillFunction =
+    std::function<void(size_t input, float *data, size_t size,
+                       std::mt19937 *rng)>;
+
+/**
+ * @brief Slow scalar reference of a layer, written for clarity only.
+ * @param[in] inputs Input blobs in the order of the case, channel blocked
+ * ones copied to the planar layout.
+ * @param[in] output Buffer for the single output in the planar layout.
+ */
+using ReferenceFunction =
+    std::function<void(const std::vector<InferenceEngine::Blob::Ptr> &inputs,
+                       float *output)>;
+
+/**
+ * @struct LayerCase
+ * @brief One cpu_extension layer instantiated with synthetic parameters and
+ * the shapes it gets in a real topology.
+ */
+struct LayerCase {
+  // name of the case, "<type>/<variant>"
+  std::string name;
+  // layer type as registered by REG_FACTORY_FOR
+  std::string type;
+  std::map<std::string, std::string> params;
+  std::vector<InferenceEngine::SizeVector> inputs;
+  std::vector<InferenceEngine::SizeVector> outputs;
+  // constant blobs of the layer, e.g. the Normalize weights
+  std::map<std::string, std::vector<float>> blobs;
+  // run the channel blocked (nChw8c or nChw16c) configuration of the layer
+  // instead of the first one
+  bool blocked = false;
+  // uniform [-1, 1] when not set, the padding of blocked inputs included
+  FillFunction fill;
+  // outputs are compared with the single thread run when not set
+  ReferenceFunction reference;
+  // allowed error relative to max(1, |expected|)
+  float tolerance = 1e-5f;
+};
+
+/**
+ * @brief Cases covering every layer of the cpu_extension library.
+ */
+std::vector<LayerCase> getLayerCases();
+}  // namespace ExtensionBench
+
+#endif //DYNAMIC_VINO_BENCH_LAYER_CASES_H
@@ -0,0 +1,452 @@
+/**
+* \brief Micro-benchmark of the cpu_extension custom layers: every layer is
+ * instantiated through its factory with synthetic parameters, timed across
+ * OpenMP thread counts and checked against a scalar reference.
+* \file bench/extension/main.cpp
+*/
+#include <omp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "inference_engine.hpp"
+#include "ext_list.hpp"
+#include "bench_utility.hpp"
+#include "layer_cases.h"
+#include "openvino_service/slog.hpp"
+#include "gflags/gflags.h"
+
+using namespace InferenceEngine;
+
+/**
+ * @struct LayerInstance
+ * @brief A layer created through the cpu_extension factory together with
+ * the blobs it is executed on.
+ */
+struct LayerInstance {
+  CNNLayerPtr layer;
+  // the layer only keeps weak pointers to its inputs
+  std::vector<DataPtr> input_data;
+  ILayerImplFactory::Ptr factory;
+  std::shared_ptr<ILayerExecImpl> impl;
+  std::vector<Blob::Ptr> inputs;
+  std::vector<Blob::Ptr> outputs;
+  // memory of the blobs, the padding of the last channel block included
+  std::vector<std::vector<float>> buffers;
+};
+
+/**
+ * @struct Measurement
+ * @brief Timing and accuracy of one layer case at one thread count.
+ */
+struct Measurement {
+  std::string name;
+  int threads;
+  double median_us;
+  double best_us;
+  double ns_per_element;
+  double gb_per_second;
+  double max_error;
+  bool has_reference;
+  bool passed;
+};
+
+bool parseAndCheckCommandLine(int argc, char **argv) {
+  gflags::ParseCommandLineNonHelpFlags(&argc, &argv, true);
+  if (FLAGS_h) {
+    showUsage();
+    return false;
+  }
+  if (FLAGS_niter < 1) {
+    throw std::logic_error("Parameter -niter cannot be 0");
+  }
+  return true;
+}
+
+std::vector<std::string> split(const std::string &list) {
+  std::vector<std::string> items;
+  std::istringstream stream(list);
+  for (std::string item; std::getline(stream, item, ',');) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+/**
+ * @brief A case is selected by its layer type or by a prefix of its name.
+ */
+bool isSelected(const ExtensionBench::LayerCase &layer_case,
+                const std::vector<std::string> &selection) {
+  if (selection.empty()) {
+    return true;
+  }
+  for (auto &item : selection) {
+    if (item == layer_case.type || layer_case.name.compare(0, item.size(),
+                                                           item) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<int> getThreadCounts() {
+  std::vector<int> threads;
+  if (!FLAGS_nthreads.empty()) {
+    for (auto &item : split(FLAGS_nthreads)) {
+      int count = std::stoi(item);
+      if (count < 1) {
+        throw std::logic_error("Parameter -nthreads must be positive");
+      }
+      threads.push_back(count);
+    }
+    return threads;
+  }
+  int max_threads = omp_get_max_threads();
+  for (int count = 1; count < max_threads; count *= 2) {
+    threads.push_back(count);
+  }
+  threads.push_back(max_threads);
+  return threads;
+}
+
+/**
+ * @brief Floats in the memory of a blob, the padding of blocked dimensions
+ * included.
+ */
+size_t getBufferSize(const TensorDesc &desc) {
+  size_t size = 1;
+  for (auto dim : desc.getBlockingDesc().getBlockDims()) {
+    size *= dim;
+  }
+  return size;
+}
+
+bool isBlocked(const LayerConfig &config) {
+  return !config.inConfs.empty() &&
+      config.inConfs[0].desc.getBlockingDesc().getBlockDims().size() == 5;
+}
+
+/**
+ * @brief Create the layer through the factory registered for its type and
+ * allocate blobs in the first configuration it supports, or in the channel
+ * blocked one when the case asks for it.
+ */
+LayerInstance createLayer(const ExtensionBench::LayerCase &layer_case,
+                          std::mt19937 *rng) {
+  using Extensions::Cpu::CpuExtensions;
+  LayerInstance instance;
+  instance.layer = std::make_shared<CNNLayer>(
+      LayerParams{layer_case.name, layer_case.type, Precision::FP32});
+  instance.layer->params = layer_case.params;
+  for (size_t i = 0; i < layer_case.inputs.size(); ++i) {
+    auto &dims = layer_case.inputs[i];
+    auto data = std::make_shared<Data>(
+        layer_case.name + "/in" + std::to_string(i),
+        TensorDesc(Precision::FP32, dims, TensorDesc::getLayoutByDims(dims)));
+    instance.input_data.push_back(data);
+    instance.layer->insData.push_back(data);
+  }
+  for (size_t i = 0; i < layer_case.outputs.size(); ++i) {
+    auto &dims = layer_case.outputs[i];
+    auto data = std::make_shared<Data>(
+        layer_case.name + "/out" + std::to_string(i),
+        TensorDesc(Precision::FP32, dims, TensorDesc::getLayoutByDims(dims)));
+    data->creatorLayer = instance.layer;
+    instance.layer->outData.push_back(data);
+  }
+  for (auto &pair : layer_case.blobs) {
+    auto blob = make_shared_blob<float>(TensorDesc(
+        Precision::FP32, {pair.second.size()}, Layout::C));
+    blob->allocate();
+    std::copy(pair.second.begin(), pair.second.end(),
+              blob->buffer().as<float *>());
+    instance.layer->blobs[pair.first] = blob;
+  }
+
+  auto &factories = CpuExtensions::GetExtensionsHolder()->list;
+  auto factory = factories.find(layer_case.type);
+  if (factory == factories.end()) {
+    throw std::logic_error(layer_case.name + ": no factory for " +
+                           layer_case.type);
+  }
+  instance.factory.reset(factory->second(instance.layer.get()));
+
+  ResponseDesc resp;
+  std::vector<ILayerImpl::Ptr> impls;
+  if (instance.factory->getImplementations(impls, &resp) != OK ||
+      impls.empty()) {
+    throw std::logic_error(layer_case.name + ": " + resp.msg);
+  }
+  instance.impl = std::dynamic_pointer_cast<ILayerExecImpl>(impls[0]);
+  std::vector<LayerConfig> configs;
+  if (!instance.impl ||
+      instance.impl->getSupportedConfigurations(configs, &resp) != OK ||
+      configs.empty()) {
+    throw std::logic_error(layer_case.name + ": " + resp.msg);
+  }
+  auto config_it = configs.begin();
+  if (layer_case.blocked) {
+    config_it = std::find_if(configs.begin(), configs.end(), isBlocked);
+    if (config_it == configs.end()) {
+      throw std::logic_error(layer_case.name +
+                             ": no channel blocked configuration");
+    }
+  }
+  LayerConfig &config = *config_it;
+  if (instance.impl->init(config, &resp) != OK) {
+    throw std::logic_error(layer_case.name + ": " + resp.msg);
+  }
+
+  // blobs only allocate their dims, without the padding of the last block
+  auto make_blob = [&instance](const DataConfig &data_config) {
+    TensorDesc desc = data_config.desc;
+    if (desc.getLayout() == Layout::ANY) {
+      desc = TensorDesc(Precision::FP32, desc.getDims(),
+                        TensorDesc::getLayoutByDims(desc.getDims()));
+    }
+    instance.buffers.emplace_back(getBufferSize(desc));
+    auto &buffer = instance.buffers.back();
+    return make_shared_blob<float>(desc, buffer.data(), buffer.size());
+  };
+  for (size_t i = 0; i < config.inConfs.size(); ++i) {
+    Blob::Ptr blob = make_blob(config.inConfs[i]);
+    float *data = blob->buffer().as<float *>();
+    size_t size = instance.buffers.back().size();
+    if (layer_case.fill) {
+      layer_case.fill(i, data, size, rng);
+    } else {
+      std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+      for (size_t j = 0; j < size; ++j) {
+        data[j] = distribution(*rng);
+      }
+    }
+    instance.inputs.push_back(blob);
+  }
+  for (auto &data_config : config.outConfs) {
+    instance.outputs.push_back(make_blob(data_config));
+  }
+  return instance;
+}
+
+/**
+ * @brief Copy of a channel blocked (nChw8c, nChw16c) blob in the planar
+ * layout, other blobs as they are.
+ */
+Blob::Ptr toPlanar(const Blob::Ptr &blob) {
+  const TensorDesc &desc = blob->getTensorDesc();
+  const SizeVector &block_dims = desc.getBlockingDesc().getBlockDims();
+  if (block_dims.size() != 5) {
+    return blob;
+  }
+  const SizeVector &dims = desc.getDims();
+  Blob::Ptr planar = make_shared_blob<float>(
+      TensorDesc(Precision::FP32, dims, Layout::NCHW));
+  planar->allocate();
+  const float *src = blob->cbuffer().as<const float *>();
+  float *dst = planar->buffer().as<float *>();
+  size_t blocks = block_dims[1], block = block_dims[4];
+  size_t spatial = dims[2] * dims[3];
+  for (size_t n = 0; n < dims[0]; ++n) {
+    for (size_t c = 0; c < dims[1]; ++c) {
+      const float *channel = src + (n * blocks + c / block) * spatial * block +
+          c % block;
+      for (size_t i = 0; i < spatial; ++i) {
+        *dst++ = channel[i * block];
+      }
+    }
+  }
+  return planar;
+}
+
+void execute(LayerInstance *instance, const std::string &name) {
+  ResponseDesc resp;
+  if (instance->impl->execute(instance->inputs, instance->outputs, &resp) !=
+      OK) {
+    throw std::logic_error(name + ": " + resp.msg);
+  }
+}
+
+/**
+ * @brief Largest difference to the expected output, relative to
+ * max(1, |expected|); infinite when the outputs disagree on NaNs.
+ */
+double getMaxError(const float *actual, const std::vector<float> &expected) {
+  double max_error = 0;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    if (std::isnan(actual[i]) != std::isnan(expected[i])) {
+      return INFINITY;
+    }
+    if (std::isnan(expected[i])) {
+      continue;
+    }
+    double error = std::fabs(actual[i] - expected[i]) /
+        std::max(1.0, std::fabs(static_cast<double>(expected[i])));
+    max_error = std::max(max_error, error);
+  }
+  return max_error;
+}
+
+std::vector<Measurement> runCase(const ExtensionBench::LayerCase &layer_case,
+                                 const std::vector<int> &thread_counts) {
+  std::mt19937 rng(42);
+  LayerInstance instance = createLayer(layer_case, &rng);
+  size_t elements = 0;
+  for (auto &blob : instance.inputs) {
+    elements += blob->size();
+  }
+  for (auto &blob : instance.outputs) {
+    elements += blob->size();
+  }
+
+  // expected output in the planar layout: the reference or the single thread
+  // run of the layer
+  const Blob::Ptr &output = instance.outputs[0];
+  std::vector<float> expected(output->size());
+  bool has_reference = static_cast<bool>(layer_case.reference);
+  if (has_reference) {
+    std::vector<Blob::Ptr> inputs;
+    for (auto &blob : instance.inputs) {
+      inputs.push_back(toPlanar(blob));
+    }
+    layer_case.reference(inputs, expected.data());
+  } else {
+    omp_set_num_threads(1);
+    execute(&instance, layer_case.name);
+    const float *data = toPlanar(output)->cbuffer().as<const float *>();
+    std::copy(data, data + output->size(), expected.begin());
+  }
+
+  std::vector<Measurement> measurements;
+  std::vector<double> times(FLAGS_niter);
+  for (int threads : thread_counts) {
+    omp_set_num_threads(threads);
+    for (size_t i = 0; i < FLAGS_warmup; ++i) {
+      execute(&instance, layer_case.name);
+    }
+    for (auto &time : times) {
+      auto start = std::chrono::steady_clock::now();
+      execute(&instance, layer_case.name);
+      time = std::chrono::duration<double, std::micro>(
+          std::chrono::steady_clock::now() - start).count();
+    }
+    std::sort(times.begin(), times.end());
+
+    Measurement measurement;
+    measurement.name = layer_case.name;
+    measurement.threads = threads;
+    measurement.median_us = times[times.size() / 2];
+    measurement.best_us = times.front();
+    measurement.ns_per_element = measurement.median_us * 1e3 / elements;
+    measurement.gb_per_second =
+        elements * sizeof(float) / (measurement.median_us * 1e3);
+    measurement.max_error = getMaxError(
+        toPlanar(output)->cbuffer().as<const float *>(), expected);
+    measurement.has_reference = has_reference;
+    measurement.passed = measurement.max_error <= layer_case.tolerance;
+    measurements.push_back(measurement);
+  }
+  return measurements;
+}
+
+// Instruction set level the layers run with
+const char *getIsaName() {
+  return Extensions::Cpu::getCpuIsaName(Extensions::Cpu::getCpuIsa());
+}
+
+void printText(const std::vector<Measurement> &measurements) {
+  std::cout << "ISA: " << getIsaName() << std::endl;
+  std::cout << std::left << std::setw(34) << "Layer" << std::right
+            << std::setw(8) << "Threads" << std::setw(12) << "Median us"
+            << std::setw(12) << "Best us" << std::setw(10) << "ns/elem"
+            << std::setw(9) << "GB/s" << std::setw(12) << "Max error"
+            << "  Check" << std::endl;
+  for (auto &m : measurements) {
+    std::cout << std::left << std::setw(34) << m.name << std::right
+              << std::fixed << std::setprecision(1) << std::setw(8)
+              << m.threads << std::setw(12) << m.median_us << std::setw(12)
+              << m.best_us << std::setprecision(3) << std::setw(10)
+              << m.ns_per_element << std::setprecision(2) << std::setw(9)
+              << m.gb_per_second << std::scientific << std::setprecision(1)
+              << std::setw(12) << m.max_error << std::defaultfloat << "  "
+              << (m.passed ? "PASS" : "FAIL")
+              << (m.has_reference ? "" : " (vs 1 thread)") << std::endl;
+  }
+}
+
+void printJson(const std::vector<Measurement> &measurements) {
+  std::cout << "[";
+  for (size_t i = 0; i < measurements.size(); ++i) {
+    auto &m = measurements[i];
+    std::cout << (i ? ", " : "") << "{\"layer\": \"" << m.name
+              << "\", \"isa\": \"" << getIsaName()
+              << "\", \"threads\": " << m.threads
+              << ", \"median_us\": " << m.median_us
+              << ", \"best_us\": " << m.best_us
+              << ", \"ns_per_element\": " << m.ns_per_element
+              << ", \"gb_per_second\": " << m.gb_per_second
+              << ", \"max_error\": "
+              << (std::isfinite(m.max_error) ? m.max_error : -1)
+              << ", \"reference\": " << (m.has_reference ? "true" : "false")
+              << ", \"passed\": " << (m.passed ? "true" : "false") << "}";
+  }
+  std::cout << "]" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  try {
+    if (!parseAndCheckCommandLine(argc, argv)) {
+      return 0;
+    }
+    auto selection = split(FLAGS_layers);
+    std::vector<ExtensionBench::LayerCase> cases;
+    for (auto &layer_case : ExtensionBench::getLayerCases()) {
+      if (isSelected(layer_case, selection)) {
+        cases.push_back(layer_case);
+      }
+    }
+    if (FLAGS_list) {
+      for (auto &layer_case : cases) {
+        std::cout << layer_case.name << std::endl;
+      }
+      return 0;
+    }
+    if (cases.empty()) {
+      throw std::logic_error("No layer case matches -layers " + FLAGS_layers);
+    }
+
+    auto thread_counts = getThreadCounts();
+    std::vector<Measurement> measurements;
+    bool passed = true;
+    for (auto &layer_case : cases) {
+      for (auto &measurement : runCase(layer_case, thread_counts)) {
+        passed = passed && measurement.passed;
+        measurements.push_back(measurement);
+      }
+    }
+    if (FLAGS_json) {
+      printJson(measurements);
+    } else {
+      printText(measurements);
+    }
+    return passed ? 0 : 1;
+  }
+  catch (const std::exception &error) {
+    slog::err << error.what() << slog::endl;
+    return 1;
+  }
+  catch (...) {
+    slog::err << "Unknown/internal exception happened." << slog::endl;
+    return 1;
+  }
+}
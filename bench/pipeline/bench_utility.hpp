@@ -0,0 +1,221 @@
+// Copyright (c) 2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <string>
+#include <gflags/gflags.h>
+#include <iostream>
+
+/// @brief message for help argument
+static const char help_message[] = "Print a usage message.";
+
+/// @brief message for input argument
+static const char input_message[] =
+    "Optional. \"synthetic\" for generated frames or path to a video file. Several comma separated inputs share the same networks (default is synthetic).";
+
+/// @brief message for synthetic frames
+static const char image_message[] =
+    "Optional. Image replayed as synthetic frames, random noise if not set.";
+static const char width_message[] =
+    "Width of the synthetic frames (default is 1280).";
+static const char height_message[] =
+    "Height of the synthetic frames (default is 720).";
+
+/// @brief message for model argument
+static const char face_detection_model_message[] =
+    "Required. Path to an .xml file with a trained face detection model.";
+static const char age_gender_model_message[] =
+    "Optional. Path to an .xml file with a trained age gender model.";
+static const char head_pose_model_message[] =
+    "Optional. Path to an .xml file with a trained head pose model.";
+static const char emotions_model_message[] =
+    "Optional. Path to an .xml file with a trained emotions model.";
+
+/// @brief message for assigning calculation to device
+static const char target_device_message[] =
+    "Specify the target device for Face Detection (CPU, GPU, FPGA, or MYRIAD).";
+static const char target_device_message_secondary[] =
+    "Specify the target device for the secondary networks (CPU, GPU, FPGA, or MYRIAD).";
+
+/// @brief message for batch size of the secondary networks
+static const char num_batch_message[] =
+    "Specify number of maximum simultaneously processed faces for the secondary networks (default is 16).";
+
+/// @brief message for the scheduling of the pipeline
+static const char num_frames_in_flight_message[] =
+    "Specify number of maximum simultaneously processed frames in the pipeline (default is 1).";
+static const char num_requests_message[] =
+    "Specify number of infer requests created for each network (default is 1).";
+static const char num_workers_message[] =
+    "Specify number of worker threads handling the finished requests, 0 to handle them on the threads of the plugins (default is 1).";
+static const char batch_delay_message[] =
+    "Specify time in milliseconds the secondary networks wait to batch the faces of several frames (default is 0, no batching).";
+
+/// @brief message for the length of the run
+static const char num_frames_message[] =
+    "Specify number of frames read from each input (default is 300).";
+static const char time_message[] =
+    "Specify maximum running time in seconds, 0 for no limit (default is 0).";
+static const char warmup_message[] =
+    "Specify number of frames read from each input before measuring (default is 10).";
+
+/// @brief message for the report
+static const char json_message[] = "Print the report as JSON.";
+
+/// @brief message for weights mapping
+static const char mmap_message[] =
+    "Map the .bin files of the models instead of reading them into memory.";
+
+/// @brief message for the mock networks
+static const char mock_message[] =
+    "Replace the networks by mock networks without inference engine, to measure the overhead of the pipeline alone: a face detection and -mock_sec secondary networks.";
+static const char mock_faces_message[] =
+    "Specify number of faces found by the mock face detection in each frame (default is 8).";
+static const char mock_secondary_message[] =
+    "Specify number of mock secondary networks (default is 3).";
+static const char mock_latency_message[] =
+    "Specify time in microseconds a request of a mock network takes (default is 0).";
+
+/// @brief message for user library argument
+static const char custom_cpu_library_message[] =
+    "Required for MKLDNN (CPU)-targeted custom layers." \
+"Absolute path to a shared library with the kernels impl.";
+
+/// @brief message for clDNN custom kernels desc
+static const char
+    custom_cldnn_message[] = "Required for clDNN (GPU)-targeted custom kernels."\
+"Absolute path to the xml file with the kernels desc.";
+
+/// @brief message for probability threshold argument
+static const char
+    thresh_output_message[] = "Probability threshold for detections.";
+
+/// \brief Define flag for showing help message <br>
+DEFINE_bool(h, false, help_message);
+
+/// \brief inputs of the pipeline <br>
+DEFINE_string(i, "synthetic", input_message);
+
+/// \brief synthetic frames <br>
+DEFINE_string(image, "", image_message);
+DEFINE_uint32(width, 1280, width_message);
+DEFINE_uint32(height, 720, height_message);
+
+/// \brief models of the pipeline, the secondary ones are optional <br>
+DEFINE_string(m, "", face_detection_model_message);
+DEFINE_string(m_ag, "", age_gender_model_message);
+DEFINE_string(m_hp, "", head_pose_model_message);
+DEFINE_string(m_em, "", emotions_model_message);
+
+/// \brief target devices <br>
+DEFINE_string(d, "CPU", target_device_message);
+DEFINE_string(d_sec, "CPU", target_device_message_secondary);
+
+/// \brief batch size of the secondary networks <br>
+DEFINE_uint32(n_sec, 16, num_batch_message);
+
+/// \brief scheduling of the pipeline <br>
+DEFINE_uint32(n_fr, 1, num_frames_in_flight_message);
+DEFINE_uint32(n_req, 1, num_requests_message);
+DEFINE_uint32(n_wk, 1, num_workers_message);
+DEFINE_uint32(batch_ms, 0, batch_delay_message);
+
+/// \brief length of the run <br>
+DEFINE_uint32(frames, 300, num_frames_message);
+DEFINE_uint32(time, 0, time_message);
+DEFINE_uint32(warmup, 10, warmup_message);
+
+/// \brief report format <br>
+DEFINE_bool(json, false, json_message);
+
+/// \brief weights mapping <br>
+DEFINE_bool(mmap, false, mmap_message);
+
+/// \brief mock networks <br>
+DEFINE_bool(mock, false, mock_message);
+DEFINE_uint32(mock_faces, 8, mock_faces_message);
+DEFINE_uint32(mock_sec, 3, mock_secondary_message);
+DEFINE_uint32(mock_us, 0, mock_latency_message);
+
+/// @brief custom kernels <br>
+DEFINE_string(c, "", custom_cldnn_message);
+DEFINE_string(l, "", custom_cpu_library_message);
+
+/// \brief detection threshold <br>
+DEFINE_double(t, 0.5, thresh_output_message);
+
+/**
+* \brief This function show a help message
+*/
+static void showUsage() {
+  std::cout << std::endl;
+  std::cout << "dynamic_vino_bench [OPTION]" << std::endl;
+  std::cout << "Options:" << std::endl;
+  std::cout << std::endl;
+  std::cout << "    -h                         " << help_message << std::endl;
+  std::cout << "    -i \"<path>\"                " << input_message
+            << std::endl;
+  std::cout << "    -image \"<path>\"            " << image_message
+            << std::endl;
+  std::cout << "    -width \"<num>\"             " << width_message
+            << std::endl;
+  std::cout << "    -height \"<num>\"            " << height_message
+            << std::endl;
+  std::cout << "    -m \"<path>\"                "
+            << face_detection_model_message << std::endl;
+  std::cout << "    -m_ag \"<path>\"             " << age_gender_model_message
+            << std::endl;
+  std::cout << "    -m_hp \"<path>\"             " << head_pose_model_message
+            << std::endl;
+  std::cout << "    -m_em \"<path>\"             " << emotions_model_message
+            << std::endl;
+  std::cout << "      -l \"<absolute_path>\"     " << custom_cpu_library_message
+            << std::endl;
+  std::cout << "          Or" << std::endl;
+  std::cout << "      -c \"<absolute_path>\"     " << custom_cldnn_message
+            << std::endl;
+  std::cout << "    -d \"<device>\"              " << target_device_message
+            << std::endl;
+  std::cout << "    -d_sec \"<device>\"          "
+            << target_device_message_secondary << std::endl;
+  std::cout << "    -n_sec \"<num>\"             " << num_batch_message
+            << std::endl;
+  std::cout << "    -n_fr \"<num>\"              " << num_frames_in_flight_message
+            << std::endl;
+  std::cout << "    -n_req \"<num>\"             " << num_requests_message
+            << std::endl;
+  std::cout << "    -n_wk \"<num>\"              " << num_workers_message
+            << std::endl;
+  std::cout << "    -batch_ms \"<num>\"          " << batch_delay_message
+            << std::endl;
+  std::cout << "    -frames \"<num>\"            " << num_frames_message
+            << std::endl;
+  std::cout << "    -time \"<sec>\"              " << time_message
+            << std::endl;
+  std::cout << "    -warmup \"<num>\"            " << warmup_message
+            << std::endl;
+  std::cout << "    -mmap                      " << mmap_message << std::endl;
+  std::cout << "    -mock                      " << mock_message << std::endl;
+  std::cout << "    -mock_faces \"<num>\"        " << mock_faces_message
+            << std::endl;
+  std::cout << "    -mock_sec \"<num>\"          " << mock_secondary_message
+            << std::endl;
+  std::cout << "    -mock_us \"<num>\"           " << mock_latency_message
+            << std::endl;
+  std::cout << "    -json                      " << json_message << std::endl;
+  std::cout << "    -t                         " << thresh_output_message
+            << std::endl;
+}
@@ -0,0 +1,356 @@
+/**
+* \brief Headless benchmark of the whole inference graph: face detection and
+ * the optional emotions, age gender and head pose networks, over synthetic
+ * frames or video files, reporting throughput, per-stage latency, CPU
+ * utilization and peak memory.
+* \file bench/pipeline/main.cpp
+*/
+#include <sys/resource.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "inference_engine.hpp"
+#include "opencv2/opencv.hpp"
+#include "bench_utility.hpp"
+#include "mock_inference.h"
+#include "null_output.h"
+#include "synthetic_input.h"
+#include "openvino_service/pipeline.h"
+#include "openvino_service/inferences/age_gender_recognition.h"
+#include "openvino_service/inferences/emotions_recognition.h"
+#include "openvino_service/inferences/head_pose_recognition.h"
+#include "openvino_service/inferences/face_detection.h"
+#include "openvino_service/engines/engine.h"
+#include "openvino_service/engines/engine_loader.h"
+#include "openvino_service/slog.hpp"
+#include "openvino_service/factory.h"
+#include "gflags/gflags.h"
+
+using namespace InferenceEngine;
+
+bool parseAndCheckCommandLine(int argc, char **argv) {
+  gflags::ParseCommandLineNonHelpFlags(&argc, &argv, true);
+  if (FLAGS_h) {
+    showUsage();
+    return false;
+  }
+  if (FLAGS_m.empty() && !FLAGS_mock) {
+    throw std::logic_error("Parameter -m is not set");
+  }
+  if (FLAGS_n_sec < 1) {
+    throw std::logic_error("Parameter -n_sec cannot be 0");
+  }
+  if (FLAGS_n_fr < 1) {
+    throw std::logic_error("Parameter -n_fr cannot be 0");
+  }
+  if (FLAGS_n_req < 1) {
+    throw std::logic_error("Parameter -n_req cannot be 0");
+  }
+  return true;
+}
+
+/**
+ * @brief A secondary network working on the faces found by the face
+ * detection network, created once its engine is loaded.
+ */
+struct SecondaryNetwork {
+  std::string name;
+  std::shared_ptr<Models::BaseModel> model;
+  size_t engine_id;
+  std::function<std::shared_ptr<openvino_service::BaseInference>(
+      std::shared_ptr<Engines::Engine>)> make_inference;
+};
+
+/**
+ * @brief Register a secondary network with the engine loader.
+ */
+template<typename ModelT, typename InferenceT>
+SecondaryNetwork addSecondaryNetwork(
+    const std::string &name, const std::string &model_path, int output_num,
+    InferencePlugin &plugin, Engines::EngineLoader *engine_loader) {
+  auto model = std::make_shared<ModelT>(model_path, 1, output_num,
+                                        static_cast<int>(FLAGS_n_sec));
+  model->setWeightsMapping(FLAGS_mmap);
+  SecondaryNetwork network;
+  network.name = name;
+  network.model = model;
+  network.engine_id = engine_loader->add(model, plugin, FLAGS_n_req);
+  network.make_inference = [model](std::shared_ptr<Engines::Engine> engine) {
+    auto inference = std::make_shared<InferenceT>();
+    inference->loadNetwork(model);
+    inference->loadEngine(engine);
+    if (FLAGS_batch_ms > 0) {
+      inference->setBatchingPolicy(true,
+                                   std::chrono::milliseconds(FLAGS_batch_ms));
+    }
+    return std::static_pointer_cast<openvino_service::BaseInference>(
+        inference);
+  };
+  return network;
+}
+
+/**
+ * @brief CPU time (user and system) used by the process so far, in seconds.
+ */
+double getCpuSeconds() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+      (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+/**
+ * @brief Peak resident set size of the process, in kilobytes.
+ */
+long getPeakRssKb() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+/**
+ * @brief Run the pipeline once, returning false at the end of an input.
+ */
+bool runOnce(Pipeline *pipe) {
+  try {
+    pipe->runOnce();
+  } catch (const std::logic_error &error) {
+    slog::info << error.what() << slog::endl;
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  try {
+    if (!parseAndCheckCommandLine(argc, argv)) {
+      return 0;
+    }
+
+    // --------------------------- 1. Load Plugin for inference engine -------------------------------------
+    std::map<std::string, InferencePlugin> plugins_for_devices;
+    for (auto &device_name : {FLAGS_d, FLAGS_d_sec}) {
+      if (!FLAGS_mock &&
+          plugins_for_devices.find(device_name) == plugins_for_devices.end()) {
+        plugins_for_devices[device_name] = *Factory::makePluginByName(
+            device_name, FLAGS_l, FLAGS_c, false);
+      }
+    }
+
+    // --------------------------- 2. Generate Input and Output Devices-------------------------------------
+    std::vector<std::string> inputs;
+    std::istringstream input_list(FLAGS_i);
+    for (std::string input; std::getline(input_list, input, ',');) {
+      inputs.push_back(input);
+    }
+    Pipeline pipe;
+    std::vector<std::shared_ptr<Outputs::NullOutput>> outputs;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      std::unique_ptr<Input::BaseInputDevice> input_ptr;
+      bool init;
+      if (inputs[i] == "synthetic") {
+        input_ptr = std::make_unique<Input::SyntheticInput>(FLAGS_image);
+        init = input_ptr->initialize(FLAGS_width, FLAGS_height);
+      } else {
+        input_ptr = Factory::makeInputDeviceByName(inputs[i]);
+        init = input_ptr->initialize();
+      }
+      if (!init) {
+        throw std::logic_error("Cannot open input: " + inputs[i]);
+      }
+      pipe.add("input_" + std::to_string(i), std::move(input_ptr));
+      outputs.push_back(std::make_shared<Outputs::NullOutput>());
+    }
+
+    // --------------------------- 3. Build Pipeline -------------------------------------------------------
+    // reading, loading and warming up the networks, all at the same time
+    auto setup_start = std::chrono::steady_clock::now();
+    Engines::EngineLoader engine_loader;
+    std::shared_ptr<openvino_service::BaseInference> face_inference_ptr;
+    std::vector<std::pair<std::string,
+                          std::shared_ptr<openvino_service::BaseInference>>>
+        secondary;
+    if (FLAGS_mock) {
+      auto latency = std::chrono::microseconds(FLAGS_mock_us);
+      face_inference_ptr = std::make_shared<openvino_service::MockInference>(
+          "face_detection", static_cast<int>(FLAGS_mock_faces), 1,
+          FLAGS_n_req, latency);
+      for (size_t i = 0; i < FLAGS_mock_sec; ++i) {
+        std::string name = "secondary_" + std::to_string(i);
+        auto inference = std::make_shared<openvino_service::MockInference>(
+            name, 0, static_cast<int>(FLAGS_n_sec), FLAGS_n_req, latency);
+        if (FLAGS_batch_ms > 0) {
+          inference->setBatchingPolicy(
+              true, std::chrono::milliseconds(FLAGS_batch_ms));
+        }
+        secondary.emplace_back(name, inference);
+      }
+    } else {
+      auto face_detection_model =
+          std::make_shared<Models::FaceDetectionModel>(FLAGS_m, 1, 1, 1);
+      face_detection_model->setWeightsMapping(FLAGS_mmap);
+      size_t face_detection_engine_id = engine_loader.add(
+          face_detection_model, plugins_for_devices[FLAGS_d], FLAGS_n_req);
+      std::vector<SecondaryNetwork> secondary_networks;
+      auto &secondary_plugin = plugins_for_devices[FLAGS_d_sec];
+      if (!FLAGS_m_em.empty()) {
+        secondary_networks.push_back(addSecondaryNetwork<
+            Models::EmotionDetectionModel,
+            openvino_service::EmotionsDetection>(
+            "emotions_detection", FLAGS_m_em, 1, secondary_plugin,
+            &engine_loader));
+      }
+      if (!FLAGS_m_ag.empty()) {
+        secondary_networks.push_back(addSecondaryNetwork<
+            Models::AgeGenderDetectionModel,
+            openvino_service::AgeGenderDetection>(
+            "age_gender_detection", FLAGS_m_ag, 2, secondary_plugin,
+            &engine_loader));
+      }
+      if (!FLAGS_m_hp.empty()) {
+        secondary_networks.push_back(addSecondaryNetwork<
+            Models::HeadPoseDetectionModel,
+            openvino_service::HeadPoseDetection>(
+            "headpose_detection", FLAGS_m_hp, 3, secondary_plugin,
+            &engine_loader));
+      }
+      engine_loader.start(1);
+      engine_loader.wait();
+
+      auto face_detection =
+          std::make_shared<openvino_service::FaceDetection>(FLAGS_t);
+      face_detection->loadNetwork(face_detection_model);
+      face_detection->loadEngine(
+          engine_loader.getEngine(face_detection_engine_id));
+      face_inference_ptr = face_detection;
+      for (auto &network : secondary_networks) {
+        secondary.emplace_back(network.name, network.make_inference(
+            engine_loader.getEngine(network.engine_id)));
+      }
+    }
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      std::string input_name = "input_" + std::to_string(i);
+      std::string output_name = "output_" + std::to_string(i);
+      if (i == 0) {
+        pipe.add(input_name, "face_detection", face_inference_ptr);
+        for (auto &pair : secondary) {
+          pipe.add("face_detection", pair.first, pair.second);
+        }
+      } else {
+        pipe.add(input_name, "face_detection");
+      }
+      if (secondary.empty()) {
+        pipe.add("face_detection", output_name, outputs[i]);
+      }
+      for (auto &pair : secondary) {
+        pipe.add(pair.first, output_name, outputs[i]);
+      }
+      pipe.routeOutput(output_name, input_name);
+    }
+    pipe.setMaxInFlightFrames(FLAGS_n_fr);
+    pipe.setWorkerThreads(FLAGS_n_wk);
+    pipe.setCallback();
+    double setup_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - setup_start).count();
+
+    // --------------------------- 4. Run Pipeline ---------------------------------------------------------
+    bool input_left = true;
+    for (size_t i = 0; i < FLAGS_warmup && input_left; ++i) {
+      input_left = runOnce(&pipe);
+    }
+    pipe.flush();
+    pipe.getProfiler().reset();
+
+    auto start = std::chrono::steady_clock::now();
+    double cpu_start = getCpuSeconds();
+    size_t frames = 0;
+    while (input_left && frames < FLAGS_frames) {
+      if (FLAGS_time > 0 && std::chrono::steady_clock::now() - start >=
+          std::chrono::seconds(FLAGS_time)) {
+        break;
+      }
+      input_left = runOnce(&pipe);
+      if (input_left) {
+        ++frames;
+      }
+    }
+    pipe.flush();
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+    double cpu_seconds = getCpuSeconds() - cpu_start;
+
+    // --------------------------- 5. Report ---------------------------------------------------------------
+    size_t total_frames = frames * inputs.size();
+    size_t results = 0;
+    for (auto &output : outputs) {
+      results += output->getResults();
+    }
+    double fps = seconds > 0 ? total_frames / seconds : 0;
+    // 100% is one busy core
+    double cpu_utilization = seconds > 0 ? 100 * cpu_seconds / seconds : 0;
+    unsigned cores = std::thread::hardware_concurrency();
+    if (FLAGS_json) {
+      std::cout << "{\"inputs\": " << inputs.size()
+                << ", \"frames\": " << total_frames
+                << ", \"setup_seconds\": " << setup_seconds
+                << ", \"models\": [";
+      auto &timings = engine_loader.getTimings();
+      for (size_t i = 0; i < timings.size(); ++i) {
+        std::cout << (i == 0 ? "" : ", ")
+                  << "{\"name\": \"" << timings[i].name
+                  << "\", \"load_ms\": " << timings[i].load_ms
+                  << ", \"compile_ms\": " << timings[i].compile_ms
+                  << ", \"warm_up_ms\": " << timings[i].warm_up_ms << "}";
+      }
+      std::cout << "]"
+                << ", \"seconds\": " << seconds
+                << ", \"fps\": " << fps
+                << ", \"results\": " << results
+                << ", \"frames_in_flight\": " << FLAGS_n_fr
+                << ", \"requests\": " << FLAGS_n_req
+                << ", \"workers\": " << FLAGS_n_wk
+                << ", \"batch_size\": " << FLAGS_n_sec
+                << ", \"batch_ms\": " << FLAGS_batch_ms
+                << ", \"cpu_utilization\": " << cpu_utilization
+                << ", \"cores\": " << cores
+                << ", \"peak_rss_kb\": " << getPeakRssKb()
+                << ", \"statistics\": " << pipe.getProfiler().toJson()
+                << "}" << std::endl;
+    } else {
+      std::cout << "Frames:          " << total_frames << " from "
+                << inputs.size() << " input(s)" << std::endl;
+      std::cout << "Setup time:      " << setup_seconds << " s" << std::endl;
+      for (auto &timings : engine_loader.getTimings()) {
+        std::cout << "  " << timings.name << ": load " << timings.load_ms
+                  << " ms, compile " << timings.compile_ms
+                  << " ms, warm-up " << timings.warm_up_ms << " ms"
+                  << std::endl;
+      }
+      std::cout << "Time:            " << seconds << " s" << std::endl;
+      std::cout << "Throughput:      " << fps << " FPS" << std::endl;
+      std::cout << "Results:         " << results << std::endl;
+      std::cout << "CPU utilization: " << cpu_utilization << "% ("
+                << cores << " cores)" << std::endl;
+      std::cout << "Peak RSS:        " << getPeakRssKb() / 1024 << " MB"
+                << std::endl;
+      std::cout << pipe.getProfiler().toText() << std::endl;
+    }
+    return 0;
+  }
+  catch (const std::exception &error) {
+    slog::err << error.what() << slog::endl;
+    return 1;
+  }
+  catch (...) {
+    slog::err << "Unknown/internal exception happened." << slog::endl;
+    return 1;
+  }
+}
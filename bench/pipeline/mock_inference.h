@@ -0,0 +1,130 @@
+/**
+ * @brief A header file with declaration for MockInference class
+ * @file mock_inference.h
+ */
+#ifndef DYNAMIC_VINO_BENCH_MOCK_INFERENCE_H
+#define DYNAMIC_VINO_BENCH_MOCK_INFERENCE_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "openvino_service/engines/engine.h"
+#include "openvino_service/inferences/base_inference.h"
+
+namespace openvino_service {
+/**
+ * @class MockInference
+ * @brief Inference without network, to measure the overhead of the pipeline
+ * alone. Nothing is packed, the submitted requests finish on a device thread
+ * after a fixed latency and call the pipeline back like the plugins do. A
+ * detection finds the same number of faces in every frame, a classifier
+ * gives one result per face.
+ */
+class MockInference : public BaseInference {
+ public:
+  /**
+   * @param[in] name Name of the inference.
+   * @param[in] faces Number of faces found in each frame, 0 for a classifier.
+   * @param[in] max_batch_size Maximum number of inputs of a request.
+   * @param[in] request_num Number of requests of the mock engine.
+   * @param[in] latency Time between submitting and finishing a request.
+   */
+  MockInference(const std::string &name, int faces, int max_batch_size,
+                size_t request_num, std::chrono::microseconds latency)
+      : name_(name), faces_(faces), latency_(latency) {
+    setMaxBatchSize(max_batch_size);
+    loadEngine(std::make_shared<Engines::Engine>(request_num));
+    getResultTable() = ResultTable(
+        faces > 0 ? ResultKind::FACE_DETECTION : ResultKind::EMOTIONS, 0);
+    device_ = std::thread(&MockInference::run, this);
+  }
+  ~MockInference() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    device_.join();
+  }
+  bool enqueue(const cv::Mat &, const cv::Rect &input_frame_loc) override {
+    return reserveSlot(input_frame_loc) >= 0;
+  }
+  bool submitRequest() override {
+    int request_id = takeEnqueuedRequest();
+    if (request_id < 0) {
+      discardEnqueuedRequest();
+      return false;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      running_.emplace_back(std::chrono::steady_clock::now() + latency_,
+                            static_cast<size_t>(request_id));
+    }
+    cv_.notify_all();
+    return true;
+  }
+  bool fetchResults() override {
+    if (!BaseInference::fetchResults()) return false;
+    ResultTable &results = getResultTable();
+    results.clear();
+    for (auto &location : getFinishedLocations()) {
+      if (faces_ == 0) {
+        results.setConfidence(results.addRow(location), 1);
+        continue;
+      }
+      // faces side by side on the top of the frame
+      const int size = 64;
+      const int room = std::max(1, location.width - size);
+      for (int i = 0; i < faces_; ++i) {
+        size_t row = results.addRow(
+            cv::Rect(i * size % room, 0, size, size));
+        results.setConfidence(row, 1);
+      }
+    }
+    return true;
+  }
+  const std::string getName() const override { return name_; }
+
+ private:
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [this]() { return stopping_ || !running_.empty(); });
+      if (running_.empty()) {
+        return;
+      }
+      // all requests have the same latency, so they finish in order
+      auto deadline = running_.front().first;
+      if (std::chrono::steady_clock::now() < deadline) {
+        cv_.wait_until(lock, deadline);
+        continue;
+      }
+      size_t request_id = running_.front().second;
+      running_.pop_front();
+      lock.unlock();
+      getEngine()->getCompletionCallback()(request_id);
+      lock.lock();
+    }
+  }
+
+  std::string name_;
+  int faces_;
+  std::chrono::microseconds latency_;
+  // submitted requests with the time they finish
+  std::deque<std::pair<std::chrono::steady_clock::time_point, size_t>>
+      running_;
+  bool stopping_ = false;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::thread device_;
+};
+}
+
+#endif //DYNAMIC_VINO_BENCH_MOCK_INFERENCE_H
@@ -0,0 +1,31 @@
+/**
+ * @brief A header file with declaration for NullOutput class
+ * @file null_output.h
+ */
+#ifndef DYNAMIC_VINO_BENCH_NULL_OUTPUT_H
+#define DYNAMIC_VINO_BENCH_NULL_OUTPUT_H
+
+#include "openvino_service/outputs/base_output.h"
+
+namespace Outputs {
+/**
+ * @class NullOutput
+ * @brief Headless output device which only counts what it receives.
+ */
+class NullOutput : public BaseOutput {
+ public:
+  void accept(const openvino_service::ResultTable &results) override {
+    results_ += results.size();
+  }
+  void feedFrame(const cv::Mat &) override { ++frames_; }
+  void handleOutput(const std::string &overall_output_text) override {}
+  inline size_t getFrames() const { return frames_; }
+  inline size_t getResults() const { return results_; }
+
+ private:
+  size_t frames_ = 0;
+  size_t results_ = 0;
+};
+}
+
+#endif //DYNAMIC_VINO_BENCH_NULL_OUTPUT_H
@@ -0,0 +1,60 @@
+/**
+ * @brief A header file with declaration for SyntheticInput class
+ * @file synthetic_input.h
+ */
+#ifndef DYNAMIC_VINO_BENCH_SYNTHETIC_INPUT_H
+#define DYNAMIC_VINO_BENCH_SYNTHETIC_INPUT_H
+
+#include <string>
+
+#include <opencv2/opencv.hpp>
+#include "openvino_service/inputs/base_input.h"
+
+namespace Input {
+/**
+ * @class SyntheticInput
+ * @brief Input device producing frames without camera or video: the same
+ * still image (so that faces are found and the whole graph runs) or random
+ * noise, copied into a new frame for every read.
+ */
+class SyntheticInput : public BaseInputDevice {
+ public:
+  /**
+   * @param[in] image Path to the image to replay, random noise if empty.
+   */
+  explicit SyntheticInput(const std::string &image) : image_path_(image) {}
+  bool initialize() override { return initialize(1280, 720); }
+  bool initialize(int t) override { return initialize(); }
+  bool initialize(size_t width, size_t height) override {
+    cv::Mat image;
+    if (!image_path_.empty()) {
+      image = cv::imread(image_path_);
+      if (image.empty()) {
+        setInitStatus(false);
+        return false;
+      }
+      cv::resize(image, image_, cv::Size(width, height));
+    } else {
+      image_.create(height, width, CV_8UC3);
+      cv::randu(image_, cv::Scalar::all(0), cv::Scalar::all(255));
+    }
+    setWidth(width);
+    setHeight(height);
+    setInitStatus(true);
+    return true;
+  }
+  bool read(cv::Mat *frame) override {
+    if (!isInit()) { return false; }
+    *frame = acquireFrame();
+    image_.copyTo(*frame);
+    return true;
+  }
+  void config() override {}
+
+ private:
+  std::string image_path_;
+  cv::Mat image_;
+};
+}
+
+#endif //DYNAMIC_VINO_BENCH_SYNTHETIC_INPUT_H
@@ -0,0 +1,71 @@
+# Copyright (c) 2018 Intel Corporation
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Script run after linking a library holding code built for several ISA levels,
+# see check_target_isa_leaks():
+#   cmake -DLIBRARY=<file> -DNM=<nm> -DOBJDUMP=<objdump> -DAWK=<awk> -P CheckIsaLeaks.cmake
+#
+# The weak functions outside of the isa_* namespaces are the inline code the
+# levels share (standard library, Inference Engine headers), of which the linker
+# keeps one copy. The library is removed and the build fails if one of these
+# copies holds instructions beyond SSE2, i.e. comes from the build of a level
+# some CPUs cannot run.
+
+execute_process(COMMAND ${NM} --defined-only ${LIBRARY}
+        OUTPUT_VARIABLE SYMBOLS
+        RESULT_VARIABLE RESULT)
+if(NOT RESULT EQUAL 0)
+    message(FATAL_ERROR "Cannot read the symbols of ${LIBRARY}")
+endif()
+
+string(REGEX MATCHALL "[^\n]* W [^\n]*" WEAK_SYMBOLS "${SYMBOLS}")
+set(SHARED_SYMBOLS "")
+foreach(LINE ${WEAK_SYMBOLS})
+    string(REGEX REPLACE ".* W " "" NAME "${LINE}")
+    if(NOT NAME MATCHES "isa_(ANY|SSE42|AVX2|AVX512F)")
+        set(SHARED_SYMBOLS "${SHARED_SYMBOLS}${NAME}\n")
+    endif()
+endforeach()
+set(SYMBOL_FILE "${LIBRARY}.shared_symbols")
+file(WRITE ${SYMBOL_FILE} "${SHARED_SYMBOLS}")
+
+# VEX/EVEX instructions, YMM/ZMM/opmask registers, and SSE3 to SSE4.2 instructions
+set(AWK_PROGRAM "
+BEGIN { while ((getline line < symbols) > 0) shared[line] = 1 }
+/^[0-9a-f]+ <.*>:$/ {
+    name = $2
+    gsub(/^<|>:$/, \"\", name)
+    current = (name in shared) ? name : \"\"
+    next
+}
+current != \"\" && /:\t(v[a-z0-9]+([ \t]|$)|.*%[yz]mm|.*%k[1-7]|(pshufb|palignr|phadd|phsub|pmaddubsw|pmulhrsw|psign|pabs|pblend|blendp|blendvp|dpp|insertps|extractps|pextr[bdq]|pinsr[bdq]|pmaxs[bd]|pmaxu[wd]|pmins[bd]|pminu[wd]|pmovsx|pmovzx|pmuldq|pmulld|ptest|round[ps][sd]|packusdw|pcmpeqq|pcmpgtq|pcmpestr|pcmpistr|crc32|popcnt|movntdqa|mpsadbw|phminposuw|lddqu|movddup|movs[hl]dup|hadd|hsub|addsub))/ {
+    print current
+    current = \"\"
+}
+")
+execute_process(COMMAND ${OBJDUMP} -d --no-show-raw-insn ${LIBRARY}
+        COMMAND ${AWK} -v symbols=${SYMBOL_FILE} ${AWK_PROGRAM}
+        OUTPUT_VARIABLE LEAKS
+        RESULT_VARIABLE RESULT)
+file(REMOVE ${SYMBOL_FILE})
+if(NOT RESULT EQUAL 0)
+    message(FATAL_ERROR "Cannot disassemble ${LIBRARY}")
+endif()
+
+string(STRIP "${LEAKS}" LEAKS)
+if(NOT LEAKS STREQUAL "")
+    file(REMOVE ${LIBRARY})
+    message(FATAL_ERROR "${LIBRARY} took inline functions shared by its ISA levels from the build of a higher level, "
+            "link the build for any CPU first or move them into EXT_ISA_NAMESPACE:\n${LEAKS}")
+endif()
@@ -1,6 +1,8 @@
 #
 # service functions:
 #   set_target_cpu_flags
+#   set_target_isa_flags
+#   check_target_isa_leaks
 #   set_target_vectorizer_report_flags
 #   print_target_compiler_options
 
@@ -122,6 +124,80 @@ function(set_target_cpu_flags TARGET_NAME)
 endfunction()
 
 
+# set compilation options of a target built for one ISA level (ANY, SSE42, AVX2
+# or AVX512F) whatever the host processor is, used to build the same sources
+# once per level and select one of the builds at runtime
+function(set_target_isa_flags TARGET_NAME ISA)
+    if(${ISA} STREQUAL "AVX512F")
+        target_compile_definitions(${TARGET_NAME} PRIVATE "-DHAVE_SSE" "-DHAVE_AVX2" "-DHAVE_AVX512F")
+    elseif(${ISA} STREQUAL "AVX2")
+        target_compile_definitions(${TARGET_NAME} PRIVATE "-DHAVE_SSE" "-DHAVE_AVX2")
+    elseif(${ISA} STREQUAL "SSE42")
+        target_compile_definitions(${TARGET_NAME} PRIVATE "-DHAVE_SSE")
+    endif()
+
+    if(WIN32)
+        if(CMAKE_CXX_COMPILER_ID STREQUAL "Intel")
+            if(${ISA} STREQUAL "AVX512F")
+                target_compile_options(${TARGET_NAME} PRIVATE "/QxCOMMON-AVX512")
+            elseif(${ISA} STREQUAL "AVX2")
+                target_compile_options(${TARGET_NAME} PRIVATE "/QxCORE-AVX2")
+            elseif(${ISA} STREQUAL "SSE42")
+                target_compile_options(${TARGET_NAME} PRIVATE "/QxSSE4.2")
+            endif()
+        endif()
+        if(CMAKE_CXX_COMPILER_ID STREQUAL "MSVC")
+            # MSVC accepts the intrinsics of every level, /arch only changes the generated code
+            if(${ISA} STREQUAL "AVX512F" OR ${ISA} STREQUAL "AVX2")
+                target_compile_options(${TARGET_NAME} PRIVATE "/arch:AVX2")
+            endif()
+        endif()
+    endif()
+    if(UNIX)
+        if(CMAKE_CXX_COMPILER_ID STREQUAL "Intel")
+            if(${ISA} STREQUAL "AVX512F")
+                target_compile_options(${TARGET_NAME} PRIVATE "-xCOMMON-AVX512")
+            elseif(${ISA} STREQUAL "AVX2")
+                target_compile_options(${TARGET_NAME} PRIVATE "-xCORE-AVX2")
+            elseif(${ISA} STREQUAL "SSE42")
+                target_compile_options(${TARGET_NAME} PRIVATE "-xSSE4.2")
+            endif()
+        endif()
+        if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU" OR CMAKE_CXX_COMPILER_ID STREQUAL "Clang")
+            if(${ISA} STREQUAL "AVX512F")
+                target_compile_options(${TARGET_NAME} PRIVATE "-mavx512f" "-mfma")
+            elseif(${ISA} STREQUAL "AVX2")
+                target_compile_options(${TARGET_NAME} PRIVATE "-mavx2" "-mfma")
+            elseif(${ISA} STREQUAL "SSE42")
+                target_compile_options(${TARGET_NAME} PRIVATE "-msse4.2")
+            endif()
+        endif()
+    endif()
+endfunction()
+
+
+# check after linking a target holding code built with set_target_isa_flags()
+# for several levels that the inline functions the levels share come from the
+# build any CPU can run (see CheckIsaLeaks.cmake), the build fails otherwise;
+# only done with ELF binaries and the GNU binutils
+set(CHECK_ISA_LEAKS_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/CheckIsaLeaks.cmake)
+function(check_target_isa_leaks TARGET_NAME)
+    find_program(AWK_EXECUTABLE NAMES gawk mawk awk)
+    if(NOT UNIX OR APPLE OR NOT CMAKE_NM OR NOT CMAKE_OBJDUMP OR NOT AWK_EXECUTABLE)
+        message(STATUS "ISA levels of ${TARGET_NAME} are not checked")
+        return()
+    endif()
+    add_custom_command(TARGET ${TARGET_NAME} POST_BUILD
+            COMMAND ${CMAKE_COMMAND}
+                    -DLIBRARY=$<TARGET_FILE:${TARGET_NAME}>
+                    -DNM=${CMAKE_NM}
+                    -DOBJDUMP=${CMAKE_OBJDUMP}
+                    -DAWK=${AWK_EXECUTABLE}
+                    -P ${CHECK_ISA_LEAKS_SCRIPT}
+            VERBATIM)
+endfunction()
+
+
 # function set vectorization report flags in case of
 # Intel compiler (might be useful for analisys of which loops were not
 # vectorized and why)
@@ -0,0 +1,111 @@
+/**
+ * @brief A header file with declaration for BoundedQueue Class
+ * @file bounded_queue.h
+ */
+#ifndef OPENVINO_PIPELINE_LIB_BOUNDED_QUEUE_H
+#define OPENVINO_PIPELINE_LIB_BOUNDED_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace openvino_service {
+/**
+ * @class BoundedQueue
+ * @brief Lock-free bounded queue for several producers and consumers, on a
+ * ring of cells whose sequence numbers tell whether a cell is ready to be
+ * written or read (D. Vyukov's bounded MPMC queue). Operations never block,
+ * they fail when the queue is full or empty.
+ */
+template<typename T>
+class BoundedQueue {
+ public:
+  /**
+   * @param[in] capacity Number of elements the queue can hold, rounded up to
+   * the next power of two.
+   */
+  explicit BoundedQueue(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    mask_ = size - 1;
+    cells_.reset(new Cell[size]);
+    for (size_t i = 0; i < size; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+  BoundedQueue(const BoundedQueue &) = delete;
+  BoundedQueue &operator=(const BoundedQueue &) = delete;
+  /**
+   * @brief Append a copy of the value to the queue.
+   * @return Whether the value is appended, false if the queue is full.
+   */
+  bool tryPush(const T &value) {
+    Cell *cell;
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &cells_[pos & mask_];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = value;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+  /**
+   * @brief Take the first value out of the queue.
+   * @param[out] value The value taken.
+   * @return Whether a value is taken, false if the queue is empty.
+   */
+  bool tryPop(T *value) {
+    Cell *cell;
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &cells_[pos & mask_];
+      size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    *value = std::move(cell->value);
+    // do not keep a reference to the value in the ring
+    cell->value = T();
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+  /**
+   * @brief Get the number of elements the queue can hold.
+   */
+  inline size_t capacity() const { return mask_ + 1; }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_ = 0;
+  // producers and consumers update different cache lines
+  alignas(64) std::atomic<size_t> enqueue_pos_{0};
+  alignas(64) std::atomic<size_t> dequeue_pos_{0};
+};
+}
+
+#endif //OPENVINO_PIPELINE_LIB_BOUNDED_QUEUE_H
@@ -4,12 +4,19 @@
  */
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "inference_engine.hpp"
 #include "openvino_service/models/base_model.h"
 
 /**
  * @class NetworkEngine
- * @brief This class is used to get the infer request 
+ * @brief This class is used to get the infer requests
  * from a inference plugin and an inference network
  */
 namespace Engines {
@@ -17,27 +24,95 @@ class Engine {
  public:
   /**
    * @brief Create an NetworkEngine instance 
-   * from a inference plugin and an inference network.
+   * from a inference plugin and an inference network. The network is only
+   * loaded on the plugin once, engines of the same network and plugin share
+   * it through the ModelRegistry and only have their own requests.
+   * @param[in] request_num The number of infer requests in the request pool.
+   */
+  Engine(InferenceEngine::InferencePlugin, Models::BaseModel::Ptr,
+         size_t request_num = 1);
+  /**
+   * @brief Create an engine without network, whose requests are simulated
+   * by the inference using it, e.g. to measure the overhead of the pipeline.
+   * Only the request pool and the completion callback are available, the
+   * requests themselves are null.
+   * @param[in] request_num The number of requests in the request pool.
+   */
+  explicit Engine(size_t request_num);
+  /**
+   * @brief Get an inference request this instance holds.
+   * @param[in] request_id The index of the request in the request pool.
+   * @return The inference request.
    */
-  Engine(InferenceEngine::InferencePlugin, Models::BaseModel::Ptr );
+  inline InferenceEngine::InferRequest::Ptr &getRequest(size_t request_id = 0) {
+    return requests_[request_id];
+  }
   /**
-   * @brief Get the inference request this instance holds.
-   * @return The inference request this instance holds.
+   * @brief Get the number of inference requests in the request pool.
+   * @return The number of inference requests in the request pool.
    */
-  inline InferenceEngine::InferRequest::Ptr &getRequest() { return request_; }
+  inline size_t getRequestNum() const { return requests_.size(); }
   /**
-   * @brief Set a callback function for the infer request. 
+   * @brief Get the network loaded on the plugin.
+   * @return The executable network the requests are created from.
+   */
+  inline InferenceEngine::ExecutableNetwork &getExecutableNetwork() {
+    return executable_network_->executable_network;
+  }
+  /**
+   * @brief Take a free request out of the request pool. Blocks until one of
+   * the requests is released if all of them are in use.
+   * @return The index of the acquired request.
+   */
+  size_t acquireRequest();
+  /**
+   * @brief Give a request back to the request pool.
+   * @param[in] request_id The index of the request to be released.
+   */
+  void releaseRequest(size_t request_id);
+  /**
+   * @brief Run inferences on each request with zeroed inputs, so that the
+   * first frames do not pay for the first inference (memory allocation,
+   * kernel selection, cold caches). Must be called before any request is
+   * used by an inference.
+   * @param[in] iterations The number of inferences run on each request.
+   */
+  void warmUp(size_t iterations);
+  /**
+   * @brief Set a callback function for the infer requests.
    * @param[in] callbackToSet A lambda function as callback function.
-   * The callback function will be called when request is finished.
+   * The callback function will be called with the index of the request
+   * when the request is finished.
    */
   template<typename T>
   void setCompletionCallback(const T &callbackToSet) {
-    request_->SetCompletionCallback(callbackToSet);
+    completion_callback_ = callbackToSet;
+    for (size_t i = 0; i < requests_.size(); ++i) {
+      if (requests_[i] == nullptr) continue;
+      std::function<void(void)> callb = [callbackToSet, i]() {
+        callbackToSet(i);
+      };
+      requests_[i]->SetCompletionCallback(callb);
+    }
+  }
+  /**
+   * @brief Get the callback function set by setCompletionCallback(), called
+   * by the inferences simulating their requests.
+   */
+  inline const std::function<void(size_t)> &getCompletionCallback() const {
+    return completion_callback_;
   }
 
  private:
-  InferenceEngine::InferRequest::Ptr request_;
+  // shared with the other engines of the same network and plugin
+  std::shared_ptr<Models::SharedExecutableNetwork> executable_network_;
+  std::vector<InferenceEngine::InferRequest::Ptr> requests_;
+  // names of the inputs of the network, zeroed for the warm-up
+  std::vector<std::string> input_names_;
+  std::function<void(size_t)> completion_callback_;
+  std::deque<size_t> free_requests_;
+  std::mutex requests_mutex_;
+  std::condition_variable requests_cv_;
 };
 
 }
-
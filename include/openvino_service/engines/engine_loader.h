@@ -0,0 +1,97 @@
+/**
+ * @brief A header file with declaration for EngineLoader class
+ * @file engine_loader.h
+ */
+#ifndef OPENVINO_PIPELINE_LIB_ENGINE_LOADER_H
+#define OPENVINO_PIPELINE_LIB_ENGINE_LOADER_H
+
+#include <exception>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "inference_engine.hpp"
+#include "openvino_service/engines/engine.h"
+#include "openvino_service/models/base_model.h"
+
+namespace Engines {
+/**
+ * @class EngineLoader
+ * @brief Initializes the models and creates their engines at startup, all
+ * of them concurrently, then warms each engine up. The networks are loaded
+ * on each plugin one at a time by the model registry, reading the files and
+ * warming up run in parallel. The loading runs in the background, so e.g.
+ * the input devices can be opened in the meantime; the engines are handed
+ * out once they are ready.
+ */
+class EngineLoader {
+ public:
+  /**
+   * @struct Timings
+   * @brief Time spent on one model, in milliseconds.
+   */
+  struct Timings {
+    std::string name;
+    // reading the files and checking the network (modelInit)
+    double load_ms = 0;
+    // loading the network on the plugin, including waiting for the other
+    // networks loaded on it, and creating the requests
+    double compile_ms = 0;
+    double warm_up_ms = 0;
+  };
+
+  EngineLoader() = default;
+  ~EngineLoader();
+  /**
+   * @brief Register a model to be initialized and loaded on the plugin.
+   * Must be called before start().
+   * @param[in] model The model, not initialized yet.
+   * @param[in] plugin The plugin of the target device.
+   * @param[in] request_num The number of infer requests of the engine.
+   * @return The index of the engine, to be given to getEngine().
+   */
+  size_t add(std::shared_ptr<Models::BaseModel> model,
+             InferenceEngine::InferencePlugin plugin, size_t request_num = 1);
+  /**
+   * @brief Start loading all registered models, each one in its own thread.
+   * @param[in] warm_up_iterations The number of warm-up inferences run on
+   * each request of each engine, 0 for none.
+   */
+  void start(size_t warm_up_iterations = 1);
+  /**
+   * @brief Wait until every engine is loaded and warmed up.
+   * Throws the error of the first model which failed to load.
+   */
+  void wait();
+  /**
+   * @brief Get the engine of a registered model, waits until all engines are
+   * ready.
+   * @param[in] index The index returned by add().
+   */
+  std::shared_ptr<Engine> getEngine(size_t index);
+  /**
+   * @brief Get the time spent on each model, in the order they were added.
+   * Only complete after wait().
+   */
+  inline const std::vector<Timings> &getTimings() const { return timings_; }
+
+ private:
+  struct Task {
+    std::shared_ptr<Models::BaseModel> model;
+    InferenceEngine::InferencePlugin plugin;
+    size_t request_num;
+    std::shared_ptr<Engine> engine;
+  };
+  void load(size_t index, size_t warm_up_iterations);
+
+  std::vector<Task> tasks_;
+  std::vector<Timings> timings_;
+  std::vector<std::future<void>> futures_;
+  // error of the first model which failed to load
+  std::exception_ptr error_;
+  bool started_ = false;
+};
+}
+
+#endif //OPENVINO_PIPELINE_LIB_ENGINE_LOADER_H
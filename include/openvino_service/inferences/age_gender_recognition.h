@@ -16,33 +16,27 @@
 
 namespace openvino_service {
 
-class AgeGenderResult : public Result {
- public:
-  explicit AgeGenderResult(const cv::Rect &location);
-  void decorateFrame(cv::Mat *frame, cv::Mat *camera_matrix) const override ;
-
-  float age_ = -1;
-  float male_prob_ = -1;
-};
-
 // AgeGender Detection
+/**
+ * @class AgeGenderDetection
+ * @brief Age gender recognition network. Its results have the attributes
+ * AGE and MALE_PROB.
+ */
 class AgeGenderDetection : public BaseInference {
  public:
-  using Result = openvino_service::AgeGenderResult;
+  enum Attribute { AGE, MALE_PROB, ATTRIBUTE_COUNT };
   explicit AgeGenderDetection();
   ~AgeGenderDetection() override;
   void loadNetwork(std::shared_ptr<Models::AgeGenderDetectionModel>);
   bool enqueue(const cv::Mat &frame, const cv::Rect &) override;
+  size_t enqueueRegions(const cv::Mat &frame,
+                        const std::vector<cv::Rect> &input_frame_locs) override;
   bool submitRequest() override;
   bool fetchResults() override;
-  const int getResultsLength() const override;
-  const openvino_service::Result*
-  getLocationResult(int idx) const override;
   const std::string getName() const override;
 
  private:
   std::shared_ptr<Models::AgeGenderDetectionModel> valid_model_;
-  std::vector<Result> results_;
 };
 
 }
@@ -5,39 +5,65 @@
 #ifndef OPENVINO_PIPELINE_LIB_BASE_INFERENCE_H
 #define OPENVINO_PIPELINE_LIB_BASE_INFERENCE_H
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <vector>
 
 #include "opencv2/opencv.hpp"
 #include "inference_engine.hpp"
 #include "openvino_service/engines/engine.h"
+#include "openvino_service/inferences/blob_packer.h"
+#include "openvino_service/inferences/result_table.h"
 #include "openvino_service/slog.hpp"
 
 /**
- * @brief Load a frame into the input blob(memory).
- * @param[in] orig_image frame to be put.
+ * @brief Load a frame into the input blob(memory). A BGR frame of another
+ * size is resized and converted to the blob layout in one pass, so a region
+ * of the source frame can be given without copying it first.
+ * @param[in] orig_image frame to be put. An empty frame, such as a region
+ * outside of the source frame, fills the batch slot with zeros.
  * @param[in] blob Blob that points to memory.
  * @param[in] scale_factor Scale factor for loading.
  * @param[in] batch_index Indicates the batch index for the frame.
+ * @param[in] resize_buffer Buffers reused for resizing the frame to the blob
+ * size, temporary ones are allocated if it is not given.
  */
 template<typename T>
 void
 matU8ToBlob(const cv::Mat &orig_image,
             InferenceEngine::Blob::Ptr &blob,
             float scale_factor = 1.0,
-            int batch_index = 0) {
+            int batch_index = 0,
+            openvino_service::ResizeBuffer *resize_buffer = nullptr) {
   InferenceEngine::SizeVector blob_size = blob->getTensorDesc().getDims();
   const size_t width = blob_size[3];
   const size_t height = blob_size[2];
   const size_t channels = blob_size[1];
   T *blob_data = blob->buffer().as<T *>();
+  int batchOffset = batch_index * width * height * channels;
 
+  if (orig_image.empty()) {
+    std::fill(blob_data + batchOffset,
+              blob_data + batchOffset + width * height * channels, T(0));
+    return;
+  }
+  if (channels == 3 && orig_image.type() == CV_8UC3) {
+    openvino_service::ResizeBuffer local_buffer;
+    if (resize_buffer == nullptr) {
+      resize_buffer = &local_buffer;
+    }
+    openvino_service::resizeBGRToPlanar(
+        orig_image.ptr<uint8_t>(), orig_image.step,
+        orig_image.size().width, orig_image.size().height, width, height,
+        blob_data + batchOffset, scale_factor, resize_buffer);
+    return;
+  }
   cv::Mat resized_image(orig_image);
   if (width != orig_image.size().width ||
       height != orig_image.size().height) {
     cv::resize(orig_image, resized_image, cv::Size(width, height));
   }
-  int batchOffset = batch_index * width * height * channels;
-
   for (size_t c = 0; c < channels; c++) {
     for (size_t h = 0; h < height; h++) {
       for (size_t w = 0; w < width; w++) {
@@ -50,18 +76,6 @@ matU8ToBlob(const cv::Mat &orig_image,
 
 namespace openvino_service {
 
-class Result {
- public:
-  friend class BaseInference;
-  explicit Result(const cv::Rect &location);
-  inline const cv::Rect getLocation() const { return location_; }
-  virtual void decorateFrame(cv::Mat *frame, cv::Mat *camera_matrix) const = 0;
-
- private:
-  cv::Rect location_;
-
-};
-
 /**
  * @class BaseInference
  * @brief Base class for network inference.
@@ -98,12 +112,49 @@ class BaseInference {
   virtual bool
   enqueue(const cv::Mat &frame, const cv::Rect &input_frame_loc) = 0;
   /**
-   * @brief Start inference for all buffered frames.
+   * @brief Enqueue regions of a frame, e.g. the faces found in it. The
+   * regions take the next batch slots in the order of the list, whatever
+   * order they are packed in. This implementation enqueues them one by one,
+   * the derived classes can pack them in parallel.
+   * @param[in] frame The frame generated by the input device.
+   * @param[in] input_frame_locs The locations of the regions in the frame,
+   * clipped to the frame before they are enqueued.
+   * @return The number of regions enqueued, fewer than given if the batch is
+   * full.
+   */
+  virtual size_t enqueueRegions(const cv::Mat &frame,
+                                const std::vector<cv::Rect> &input_frame_locs);
+  /**
+   * @brief Start inference for all buffered frames. If the request cannot be
+   * started, it is given back to the engine and the buffered frames are
+   * dropped.
    * @return Whether this operation is successful.
    */
   virtual bool submitRequest();
   /**
-   * @brief This function will fetch the results of the previous inference and
+   * @brief Drop the buffered frames and give their request back to the
+   * engine, e.g. when packing them failed. Does nothing if no frame is
+   * buffered.
+   */
+  void discardEnqueuedRequest();
+  /**
+   * @brief Get the index of the request the enqueued frames are put into.
+   * @return The index of the request, or -1 if no frame is enqueued.
+   */
+  inline const int getEnqueuedRequest() const { return enqueue_request_; }
+  /**
+   * @brief Set the request whose results are read by the next fetchResults().
+   * It should be called when a request of the engine is finished.
+   * @param[in] request_id The index of the finished request.
+   */
+  void setFinishedRequest(size_t request_id);
+  /**
+   * @brief Give the finished request back to the request pool of the engine,
+   * after its results have been fetched.
+   */
+  void releaseFinishedRequest();
+  /**
+   * @brief This function will fetch the results of the finished request and
    * stores the results in a result buffer array. All buffered frames will be
    * cleared.
    * @return Whether the Inference object fetches a result this time
@@ -112,19 +163,45 @@ class BaseInference {
   /**
    * @brief Get the length of the buffer result array.
    */
-  virtual const int getResultsLength() const = 0;
+  inline const int getResultsLength() const {
+    return static_cast<int>(results_.size());
+  }
   /**
-   * @brief Get the location of result with respect
-   * to the frame generated by the input device.
-   * @param[in] idx The index of the result.
+   * @brief Get the results fetched by the last fetchResults(), with their
+   * locations with respect to the frame generated by the input device.
+   * @return The table of the results.
    */
-  virtual const openvino_service::Result*
-  getLocationResult(int idx) const = 0;
+  inline const ResultTable &getResults() const { return results_; }
   /**
    * @brief Get the name of the Inference instance.
    * @return The name of the Inference instance.
    */
   virtual const std::string getName() const = 0;
+  /**
+   * @brief Get the max batch size for one inference.
+   * @return The max batch size.
+   */
+  inline const int getMaxBatchSize() const { return max_batch_size_; }
+  /**
+   * @brief Let the pipeline put the inputs of consecutive frames into the
+   * same request: inputs are collected until the batch is full or the first
+   * of them has waited for max_delay. Only meant for networks with one result
+   * per input in enqueue order, such as the classifiers following a detection
+   * network.
+   * @param[in] enabled Whether inputs of several frames can share a request.
+   * @param[in] max_delay Longest time an input waits for the batch to fill.
+   */
+  void setBatchingPolicy(bool enabled, std::chrono::microseconds max_delay);
+  /**
+   * @brief Get whether inputs of several frames can share a request.
+   */
+  inline const bool isBatchingEnabled() const { return batching_enabled_; }
+  /**
+   * @brief Get the longest time an input waits for the batch to fill.
+   */
+  inline const std::chrono::microseconds getBatchingDelay() const {
+    return batching_delay_;
+  }
 
  protected:
   /**
@@ -133,34 +210,123 @@ class BaseInference {
     * @return Whether this operation is successful.
     */
   template<typename T>
-  bool enqueue(const cv::Mat &frame, const cv::Rect &,
+  bool enqueue(const cv::Mat &frame, const cv::Rect &input_frame_loc,
                float scale_factor, int batch_index,
                const std::string & input_name) {
-    if (enqueued_frames == max_batch_size_) {
+    if (reserveSlot(input_frame_loc) < 0) {
+      return false;
+    }
+    InferenceEngine::Blob::Ptr input_blob
+        = engine_->getRequest(enqueue_request_)->GetBlob(input_name);
+    matU8ToBlob<T>(frame, input_blob, scale_factor, batch_index,
+                   &slot_buffers_[batch_index]);
+    return true;
+  }
+  /**
+   * @brief Take the next batch slot of the request being filled, acquiring
+   * a request for the first slot, without packing anything into it.
+   * @param[in] input_frame_loc The location of the input put into the slot.
+   * @return The batch index of the slot, or -1 if the batch is full.
+   */
+  int reserveSlot(const cv::Rect &input_frame_loc);
+  /**
+   * @brief Take the request filled so far out of the enqueue state, to be
+   * submitted.
+   * @return The index of the request, or -1 if nothing is enqueued.
+   */
+  int takeEnqueuedRequest();
+  /**
+   * @brief Enqueue regions of a frame into the input blob, resizing them
+   * into their batch slots in parallel. Each slot is a disjoint part of the
+   * blob with its own resize buffers, and the slots are assigned in the
+   * order of the list before packing starts.
+   * @return The number of regions enqueued.
+   */
+  template<typename T>
+  size_t enqueueRegions(const cv::Mat &frame,
+                        const std::vector<cv::Rect> &input_frame_locs,
+                        float scale_factor, const std::string &input_name) {
+    size_t count = std::min(input_frame_locs.size(), static_cast<size_t>(
+        max_batch_size_ - enqueued_frames));
+    if (count < input_frame_locs.size()) {
       slog::warn << "Number of " << getName() <<
                  "input more than maximum("
                  << max_batch_size_
                  << ") processed by inference" << slog::endl;
-      return false;
+    }
+    if (count == 0) {
+      return 0;
+    }
+    if (enqueued_frames == 0) {
+      enqueue_request_ = static_cast<int>(engine_->acquireRequest());
+      request_locations_[enqueue_request_].clear();
     }
     InferenceEngine::Blob::Ptr input_blob
-        = engine_->getRequest()->GetBlob(input_name);
-    matU8ToBlob<T>(frame, input_blob, scale_factor, batch_index);
-    enqueued_frames += 1;
-    return true;
+        = engine_->getRequest(enqueue_request_)->GetBlob(input_name);
+    const int first_slot = enqueued_frames;
+    const cv::Rect frame_rect(0, 0, frame.cols, frame.rows);
+    cv::parallel_for_(cv::Range(0, static_cast<int>(count)),
+                      [&](const cv::Range &range) {
+      for (int i = range.start; i < range.end; ++i) {
+        cv::Mat region = frame(input_frame_locs[i] & frame_rect);
+        matU8ToBlob<T>(region, input_blob, scale_factor, first_slot + i,
+                       &slot_buffers_[first_slot + i]);
+      }
+    });
+    auto &locations = request_locations_[enqueue_request_];
+    locations.insert(locations.end(), input_frame_locs.begin(),
+                     input_frame_locs.begin() + count);
+    enqueued_frames += static_cast<int>(count);
+    return count;
+  }
+  /**
+   * @brief Get the finished request set by setFinishedRequest().
+   * @return The finished request.
+   */
+  inline InferenceEngine::InferRequest::Ptr getFinishedRequest() const {
+    return engine_->getRequest(finished_request_);
   }
+  /**
+   * @brief Get the index of the finished request set by setFinishedRequest().
+   * @return The index of the finished request, or -1 if there is none.
+   */
+  inline const int getFinishedRequestId() const { return finished_request_; }
+  /**
+   * @brief Get the locations of the frames enqueued in the finished request,
+   * in the order of their batch index.
+   * @return The locations of the frames in the finished request.
+   */
+  inline const std::vector<cv::Rect> &getFinishedLocations() const {
+    return request_locations_[finished_request_];
+  }
+  /**
+   * @brief Get the result table filled by fetchResults() of the derived
+   * class.
+   */
+  inline ResultTable &getResultTable() { return results_; }
   /**
    * @brief Set the max batch size for one inference.
    */
   inline void setMaxBatchSize(int max_batch_size) {
     max_batch_size_ = max_batch_size;
+    slot_buffers_.resize(max_batch_size);
   }
 
  private:
   std::shared_ptr<Engines::Engine> engine_;
   int max_batch_size_ = 1;
+  bool batching_enabled_ = false;
+  std::chrono::microseconds batching_delay_{0};
   int enqueued_frames = 0;
   bool results_fetched_ = false;
+  int enqueue_request_ = -1;
+  int finished_request_ = -1;
+  // locations of the enqueued frames, one vector per request of the engine
+  std::vector<std::vector<cv::Rect>> request_locations_;
+  // scratch buffers for resizing the enqueued frames, one per batch slot so
+  // the slots can be packed concurrently
+  std::vector<openvino_service::ResizeBuffer> slot_buffers_{1};
+  ResultTable results_;
 };
 
 }
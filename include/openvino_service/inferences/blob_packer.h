@@ -0,0 +1,96 @@
+/**
+ * @brief A header file with declaration for the functions that pack frames
+ * into the input blob(memory) of a network.
+ * @file blob_packer.h
+ */
+#ifndef OPENVINO_PIPELINE_LIB_BLOB_PACKER_H
+#define OPENVINO_PIPELINE_LIB_BLOB_PACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace openvino_service {
+/**
+ * @brief Copy an image of interleaved 8-bit BGR pixels (HWC) into planar
+ * memory (CHW), as expected by the NCHW input blob of a network.
+ * Uses the highest of SSE4.2/AVX2/AVX-512 the CPU supports, selected at
+ * runtime.
+ * @param[in] src Pointer to the first pixel of the image.
+ * @param[in] src_step Number of bytes between two rows of the image.
+ * @param[in] width Width of the image.
+ * @param[in] height Height of the image.
+ * @param[out] dst Pointer to the first element of the blue plane, the planes
+ * are width * height elements long and follow each other.
+ * @param[in] scale_factor Scale factor applied to every value.
+ */
+void packBGRToPlanar(const uint8_t *src, size_t src_step,
+                     size_t width, size_t height,
+                     uint8_t *dst, float scale_factor = 1.0f);
+/**
+ * @brief Floating point version of packBGRToPlanar.
+ */
+void packBGRToPlanar(const uint8_t *src, size_t src_step,
+                     size_t width, size_t height,
+                     float *dst, float scale_factor = 1.0f);
+/**
+ * @brief Scalar version of packBGRToPlanar for other blob precisions.
+ */
+template<typename T>
+void packBGRToPlanar(const uint8_t *src, size_t src_step,
+                     size_t width, size_t height,
+                     T *dst, float scale_factor = 1.0f) {
+  const size_t plane_size = width * height;
+  for (size_t h = 0; h < height; h++) {
+    const uint8_t *row = src + h * src_step;
+    for (size_t w = 0; w < width; w++) {
+      for (size_t c = 0; c < 3; c++) {
+        dst[c * plane_size + h * width + w] =
+            static_cast<T>(row[w * 3 + c] * scale_factor);
+      }
+    }
+  }
+}
+
+/**
+ * @class ResizeBuffer
+ * @brief Lookup tables and row buffers of resizeBGRToPlanar, kept between
+ * calls so that resizing does not allocate memory once they are large enough.
+ */
+struct ResizeBuffer {
+  // byte offsets of the left and right source pixel of each output column
+  std::vector<int> x_left;
+  std::vector<int> x_right;
+  // weight of the right source pixel of each output column
+  std::vector<float> x_weights;
+  // source rows interpolated horizontally, one plane per channel
+  std::vector<float> rows[2];
+  // source row index held by each row buffer
+  int row_index[2] = {-1, -1};
+};
+
+/**
+ * @brief Resize an image of interleaved 8-bit BGR pixels with bilinear
+ * interpolation and write it into planar memory (CHW) in one pass, without
+ * an intermediate image. The sampling grid is the same as cv::resize with
+ * cv::INTER_LINEAR.
+ * @param[in] src Pointer to the first pixel of the image, may be a region
+ * of a larger frame.
+ * @param[in] src_step Number of bytes between two rows of the image.
+ * @param[in] src_width Width of the image.
+ * @param[in] src_height Height of the image.
+ * @param[in] width Width of the planes to be written.
+ * @param[in] height Height of the planes to be written.
+ * @param[out] dst Pointer to the first element of the blue plane.
+ * @param[in] scale_factor Scale factor applied to every value.
+ * @param[in] buffer Buffers reused between calls.
+ */
+template<typename T>
+void resizeBGRToPlanar(const uint8_t *src, size_t src_step,
+                       size_t src_width, size_t src_height,
+                       size_t width, size_t height,
+                       T *dst, float scale_factor, ResizeBuffer *buffer);
+
+}
+
+#endif //OPENVINO_PIPELINE_LIB_BLOB_PACKER_H
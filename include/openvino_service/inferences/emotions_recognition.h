@@ -16,35 +16,26 @@
 
 namespace openvino_service {
 
-class EmotionsResult : public Result {
- public:
-  friend class EmotionsDetection;
-  explicit EmotionsResult(const cv::Rect &location);
-  void decorateFrame(cv::Mat *frame, cv::Mat *camera_matrix) const override ;
-
- private:
-  std::string label_ = "";
-  float confidence_ = -1;
-};
-
 //Emotions Detection
+/**
+ * @class EmotionsDetection
+ * @brief Emotions recognition network. Its results are the most probable
+ * emotion of each face, as label and confidence.
+ */
 class EmotionsDetection : public BaseInference {
  public:
-  using Result = openvino_service::EmotionsResult;
   explicit EmotionsDetection();
   ~EmotionsDetection() override;
   void loadNetwork(std::shared_ptr<Models::EmotionDetectionModel>);
   bool enqueue(const cv::Mat &, const cv::Rect &) override;
+  size_t enqueueRegions(const cv::Mat &frame,
+                        const std::vector<cv::Rect> &input_frame_locs) override;
   bool submitRequest() override;
   bool fetchResults() override;
-  const int getResultsLength() const override;
-  const openvino_service::Result*
-  getLocationResult(int idx) const override;
   const std::string getName() const override;
 
  private:
   std::shared_ptr<Models::EmotionDetectionModel> valid_model_;
-  std::vector<Result> results_;
 };
 
 }
@@ -6,6 +6,7 @@
 #define OPENVINO_PIPELINE_LIB_FACE_DETECTION_H
 
 #include <memory>
+#include <vector>
 #include <openvino_service/models/face_detection_model.h>
 
 #include "opencv2/opencv.hpp"
@@ -16,36 +17,26 @@
 
 namespace openvino_service {
 
-class FaceDetectionResult : public Result {
- public:
-  friend class FaceDetection;
-  explicit FaceDetectionResult(const cv::Rect &location);
-  void decorateFrame(cv::Mat *frame, cv::Mat *camera_matrix) const override ;
-
- private:
-  std::string label_ = "";
-  float confidence_ = -1;
-};
-
+/**
+ * @class FaceDetection
+ * @brief Face detection network. Its results are the faces found in the
+ * frame, with their confidence and label.
+ */
 class FaceDetection : public BaseInference {
  public:
-  using Result = openvino_service::FaceDetectionResult;
   explicit FaceDetection(double);
   ~FaceDetection() override;
   void loadNetwork(std::shared_ptr<Models::FaceDetectionModel>);
   bool enqueue(const cv::Mat &, const cv::Rect &) override;
   bool submitRequest() override;
   bool fetchResults() override;
-  const int getResultsLength() const override;
-  const openvino_service::Result*
-  getLocationResult(int idx) const override;
   const std::string getName() const override;
 
  private:
   std::shared_ptr<Models::FaceDetectionModel> valid_model_;
-  std::vector<Result> results_;
-  int width_ = 0;
-  int height_ = 0;
+  // sizes of the frames enqueued in each request, in the order of their batch
+  // index, to scale the detections of each frame back to it
+  std::vector<std::vector<cv::Size>> frame_sizes_;
   int max_proposal_count_;
   int object_size_;
   double show_output_thresh_ = 0;
@@ -16,37 +16,27 @@
 
 namespace openvino_service {
 
-//HeadPoseResult
-class HeadPoseResult : public Result {
- public:
-  friend class HeadPoseDetection;
-  explicit HeadPoseResult(const cv::Rect &location);
-  void decorateFrame(cv::Mat *frame, cv::Mat *camera_matrix) const override ;
-
- private:
-  float angle_y_ = -1;
-  float angle_p_ = -1;
-  float angle_r_ = -1;
-};
-
 // Head Pose Detection
+/**
+ * @class HeadPoseDetection
+ * @brief Head pose estimation network. Its results have the yaw, pitch and
+ * roll angles of each face as attributes, in degrees.
+ */
 class HeadPoseDetection : public BaseInference {
  public:
-  using Result = openvino_service::HeadPoseResult;
+  enum Attribute { ANGLE_Y, ANGLE_P, ANGLE_R, ATTRIBUTE_COUNT };
   explicit HeadPoseDetection();
   ~HeadPoseDetection() override;
   void loadNetwork(std::shared_ptr<Models::HeadPoseDetectionModel>);
   bool enqueue(const cv::Mat &frame, const cv::Rect &) override;
+  size_t enqueueRegions(const cv::Mat &frame,
+                        const std::vector<cv::Rect> &input_frame_locs) override;
   bool submitRequest() override;
   bool fetchResults() override;
-  const int getResultsLength() const override;
-  const openvino_service::Result*
-  getLocationResult(int idx) const override;
   const std::string getName() const override;
 
  private:
   std::shared_ptr<Models::HeadPoseDetectionModel> valid_model_;
-  std::vector<Result> results_;
 };
 
 }
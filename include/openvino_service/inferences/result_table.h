@@ -0,0 +1,102 @@
+/**
+ * @brief A header file with declaration for ResultTable Class
+ * @file result_table.h
+ */
+#ifndef OPENVINO_PIPELINE_LIB_RESULT_TABLE_H
+#define OPENVINO_PIPELINE_LIB_RESULT_TABLE_H
+
+#include <string>
+#include <vector>
+
+#include "opencv2/opencv.hpp"
+
+namespace openvino_service {
+/**
+ * @brief Kind of the results held by a ResultTable, the output devices draw
+ * each kind in its own way.
+ */
+enum class ResultKind {
+  FACE_DETECTION,
+  EMOTIONS,
+  AGE_GENDER,
+  HEAD_POSE
+};
+
+/**
+ * @class ResultTable
+ * @brief Results of an inference stored column by column: one location,
+ * confidence and label id per row, and a fixed number of float attributes
+ * per row whose meaning depends on the kind of the table. Labels are ids into
+ * the label list of the model. Clearing the table keeps the capacity of the
+ * columns, so results can be fetched frame after frame without allocations.
+ */
+class ResultTable {
+ public:
+  ResultTable() = default;
+  /**
+   * @param[in] kind Kind of the results.
+   * @param[in] attribute_count Number of attributes of each row.
+   * @param[in] labels Label list of the model, it must outlive the table.
+   */
+  ResultTable(ResultKind kind, int attribute_count,
+              const std::vector<std::string> *labels = nullptr);
+  inline const ResultKind getKind() const { return kind_; }
+  inline const int getAttributeCount() const { return attribute_count_; }
+  inline const size_t size() const { return locations_.size(); }
+  inline const bool empty() const { return locations_.empty(); }
+  /**
+   * @brief Remove all rows, keeping the kind, the labels and the capacity.
+   */
+  void clear();
+  /**
+   * @brief Add a row without label and with confidence and attributes -1.
+   * @param[in] location The location of the result with respect to the frame
+   * generated by the input device.
+   * @return The index of the new row.
+   */
+  size_t addRow(const cv::Rect &location);
+  /**
+   * @brief Copy the rows [begin, end) of another table of the same kind to
+   * the end of this one. An empty table takes the kind of the other one.
+   */
+  void append(const ResultTable &other, size_t begin, size_t end);
+  inline const std::vector<cv::Rect> &getLocations() const {
+    return locations_;
+  }
+  inline const cv::Rect &getLocation(size_t row) const {
+    return locations_[row];
+  }
+  inline const float getConfidence(size_t row) const {
+    return confidences_[row];
+  }
+  inline void setConfidence(size_t row, float confidence) {
+    confidences_[row] = confidence;
+  }
+  inline const int getLabelId(size_t row) const { return label_ids_[row]; }
+  inline void setLabelId(size_t row, int label_id) {
+    label_ids_[row] = label_id;
+  }
+  /**
+   * @brief Get the name of the label of a row, "label #<id>" if the model has
+   * no name for it, or an empty string for a row without label.
+   */
+  std::string getLabel(size_t row) const;
+  inline const float getAttribute(size_t row, int attribute) const {
+    return attributes_[row * attribute_count_ + attribute];
+  }
+  inline void setAttribute(size_t row, int attribute, float value) {
+    attributes_[row * attribute_count_ + attribute] = value;
+  }
+
+ private:
+  ResultKind kind_ = ResultKind::FACE_DETECTION;
+  int attribute_count_ = 0;
+  const std::vector<std::string> *labels_ = nullptr;
+  std::vector<cv::Rect> locations_;
+  std::vector<float> confidences_;
+  std::vector<int> label_ids_;
+  std::vector<float> attributes_;
+};
+}
+
+#endif //OPENVINO_PIPELINE_LIB_RESULT_TABLE_H
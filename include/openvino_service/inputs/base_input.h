@@ -7,6 +7,8 @@
 
 #include <opencv2/opencv.hpp>
 
+#include "openvino_service/inputs/frame_pool.h"
+
 /**
  * @class BaseInputDevice
  * @brief This class is an interface for three kinds of
@@ -70,10 +72,37 @@ class BaseInputDevice {
    * @param[in] is_init The initialization state to be set.
    */
   inline void setInitStatus(bool is_init) { is_init_ = is_init; }
+  /**
+   * @brief Set how many frame buffers the input device keeps for reuse. It
+   * should cover the frames in flight in the pipeline plus the frames held
+   * by the output devices.
+   * @param[in] size Maximum number of frame buffers.
+   */
+  virtual void setFramePoolSize(size_t size) {
+    frame_pool_.setCapacity(size);
+  }
+  /**
+   * @brief Get the number of frames the input device dropped so far.
+   * @return The number of dropped frames.
+   */
+  virtual size_t getDroppedFrames() const { return 0; }
+
+ protected:
+  /**
+   * @brief Get a frame buffer of the size of the input device from its pool,
+   * to read the next frame into.
+   * @return The frame buffer, or an empty frame if the size is unknown.
+   */
+  inline cv::Mat acquireFrame() {
+    return frame_pool_.acquire(static_cast<int>(height_),
+                               static_cast<int>(width_), CV_8UC3);
+  }
+
  private:
   size_t width_ = 0;
   size_t height_ = 0;
   bool is_init_ = false;
+  FramePool frame_pool_;
 };
 }
 #endif //OPENVINO_PIPELINE_LIB_BASE_INPUT_H
@@ -0,0 +1,49 @@
+/**
+ * @brief A header file with declaration for FramePool Class
+ * @file frame_pool.h
+ */
+#ifndef OPENVINO_PIPELINE_LIB_FRAME_POOL_H
+#define OPENVINO_PIPELINE_LIB_FRAME_POOL_H
+
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+namespace Input {
+/**
+ * @class FramePool
+ * @brief This class keeps preallocated frame buffers for an input device.
+ * A frame given by the pool is a cv::Mat sharing one of the buffers, which
+ * is handed out again once every copy of that cv::Mat has been released, so
+ * the frames can be passed through the pipeline by handle. The pool is used
+ * by the thread reading the input device only.
+ */
+class FramePool {
+ public:
+  /**
+   * @param[in] capacity Maximum number of buffers kept by the pool.
+   */
+  explicit FramePool(size_t capacity = 8);
+  /**
+   * @brief Get a frame buffer which is not used outside of the pool. If all
+   * buffers are in use and the pool is full, a buffer out of the pool is
+   * allocated.
+   * @param[in] rows Number of rows of the frame.
+   * @param[in] cols Number of columns of the frame.
+   * @param[in] type Type of the frame, e.g. CV_8UC3.
+   * @return The frame buffer, or an empty frame if the size is unknown.
+   */
+  cv::Mat acquire(int rows, int cols, int type);
+  /**
+   * @brief Set the maximum number of buffers kept by the pool.
+   * @param[in] capacity Maximum number of buffers.
+   */
+  void setCapacity(size_t capacity);
+
+ private:
+  size_t capacity_;
+  std::vector<cv::Mat> buffers_;
+};
+}
+
+#endif //OPENVINO_PIPELINE_LIB_FRAME_POOL_H
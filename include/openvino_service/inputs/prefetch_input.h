@@ -0,0 +1,94 @@
+/**
+ * @brief A header file with declaration for PrefetchInput class
+ * @file prefetch_input.h
+ */
+
+#ifndef OPENVINO_PIPELINE_LIB_PREFETCH_INPUT_H
+#define OPENVINO_PIPELINE_LIB_PREFETCH_INPUT_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <opencv2/opencv.hpp>
+#include "openvino_service/bounded_queue.h"
+#include "openvino_service/inputs/base_input.h"
+
+namespace Input {
+/**
+ * @class PrefetchInput
+ * @brief This class wraps another input device and reads its frames on a
+ * thread of its own into a bounded ring buffer, so that decoding overlaps
+ * with inference. When the ring buffer is full, the overflow policy decides
+ * whether the reading thread waits or a frame is dropped.
+ */
+class PrefetchInput : public BaseInputDevice {
+ public:
+  enum class OverflowPolicy {
+    BLOCK,        // wait until the pipeline takes a frame (video files)
+    DROP_OLDEST,  // replace the oldest buffered frame (live cameras)
+    DROP_NEWEST   // drop the frame just read
+  };
+  /**
+   * @param[in] device The input device to read frames from.
+   * @param[in] capacity Number of frames buffered ahead, at least 1.
+   * @param[in] policy What to do when the buffer is full.
+   */
+  explicit PrefetchInput(std::unique_ptr<BaseInputDevice> device,
+                         size_t capacity = 4,
+                         OverflowPolicy policy = OverflowPolicy::BLOCK);
+  ~PrefetchInput() override;
+  bool initialize() override;
+  bool initialize(int t) override;
+  bool initialize(size_t width, size_t height) override;
+  /**
+   * @brief Take the next buffered frame, waiting for the reading thread if
+   * the buffer is empty.
+   * @return Whether a frame is read, false at the end of the input.
+   */
+  bool read(cv::Mat *frame) override;
+  void config() override;
+  /**
+   * @brief Set the frame pool size of the wrapped device. The reading thread
+   * owns that pool, so the size is handed to it and applied before it reads
+   * the next frame.
+   */
+  void setFramePoolSize(size_t size) override;
+  /**
+   * @brief Get the number of frames dropped because the buffer was full.
+   * @return The number of dropped frames.
+   */
+  size_t getDroppedFrames() const override { return dropped_frames_.load(); }
+
+ private:
+  bool start(bool device_init);
+  void run();
+  bool tryPush(const cv::Mat &frame);
+  bool tryPop(cv::Mat *frame);
+  void waitUntil(const std::function<bool()> &ready);
+  void wakeUp();
+
+  std::unique_ptr<BaseInputDevice> device_;
+  // the ring buffer is rounded up to a power of two, the counter keeps the
+  // number of buffered frames to the requested capacity
+  size_t capacity_;
+  openvino_service::BoundedQueue<cv::Mat> frames_;
+  std::atomic<size_t> buffered_{0};
+  // frame pool size waiting for the reading thread, 0 if none
+  std::atomic<size_t> pool_size_{0};
+  OverflowPolicy policy_;
+  std::thread thread_;
+  std::atomic<bool> stop_{false};
+  std::atomic<bool> finished_{false};
+  std::atomic<size_t> dropped_frames_{0};
+  // the mutex is only taken to sleep, frames go through the ring buffer
+  std::atomic<int> waiting_{0};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+}
+
+#endif //OPENVINO_PIPELINE_LIB_PREFETCH_INPUT_H
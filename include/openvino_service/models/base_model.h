@@ -6,9 +6,11 @@
 #ifndef OPENVINO_PIPELINE_LIB_BASE_MODEL_H
 #define OPENVINO_PIPELINE_LIB_BASE_MODEL_H
 
+#include <memory>
 #include <vector>
 
 #include "inference_engine.hpp"
+#include "openvino_service/models/model_registry.h"
 
 namespace Engines {
   class Engine;
@@ -45,10 +47,17 @@ class BaseModel {
    * @return The maximum batch size of the model.
    */
   inline const int getMaxBatchSize() const { return max_batch_size_;}
+  /**
+   * @brief Read the weights through a memory mapping of the .bin file
+   * instead of into heap memory. Must be called before modelInit().
+   * @param[in] enabled Whether the weights are mapped.
+   */
+  inline void setWeightsMapping(bool enabled) { map_weights_ = enabled; }
   /**
    * @brief Initialize the model. During the process the class will check
    * the network input, output size, check layer property and
-   * set layer property.
+   * set layer property. The files are only read by the first model created
+   * from them, the other ones share its network through the ModelRegistry.
    */
   void modelInit();
   /**
@@ -75,11 +84,12 @@ class BaseModel {
   friend class Engines::Engine;
 
   void checkNetworkSize(int, int, InferenceEngine::CNNNetReader::Ptr);
-  InferenceEngine::CNNNetReader::Ptr net_reader_;
+  std::shared_ptr<SharedNetwork> network_;
   std::vector<std::string> labels_;
   int input_num_;
   int output_num_;
   int max_batch_size_;
+  bool map_weights_ = false;
   std::string model_loc_;
 };
 
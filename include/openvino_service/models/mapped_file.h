@@ -0,0 +1,39 @@
+/**
+ * @brief A header file with declaration for MappedFile Class
+ * @file mapped_file.h
+ */
+#ifndef OPENVINO_PIPELINE_LIB_MAPPED_FILE_H
+#define OPENVINO_PIPELINE_LIB_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Models {
+/**
+ * @class MappedFile
+ * @brief Private copy-on-write memory mapping of a whole file. The pages come
+ * from the page cache, so processes mapping the same file share them instead
+ * of each holding a private copy. A page written to is copied for the process
+ * and the file is never modified.
+ */
+class MappedFile {
+ public:
+  /**
+   * @brief Map the file, throws std::logic_error if it cannot be mapped.
+   * @param[in] file_name The name of the file to be mapped.
+   */
+  explicit MappedFile(const std::string &file_name);
+  ~MappedFile();
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  inline uint8_t *data() const { return data_; }
+  inline const size_t size() const { return size_; }
+
+ private:
+  uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+};
+}
+
+#endif //OPENVINO_PIPELINE_LIB_MAPPED_FILE_H
@@ -0,0 +1,122 @@
+/**
+ * @brief A header file with declaration for ModelRegistry Class
+ * @file model_registry.h
+ */
+#ifndef OPENVINO_PIPELINE_LIB_MODEL_REGISTRY_H
+#define OPENVINO_PIPELINE_LIB_MODEL_REGISTRY_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "inference_engine.hpp"
+#include "openvino_service/models/mapped_file.h"
+
+namespace Models {
+/**
+ * @struct SharedNetwork
+ * @brief A network read from its .xml, .bin and .labels files, shared by
+ * all the models created from the same files with the same batch size.
+ */
+struct SharedNetwork {
+  // mapped .bin file the weights blob points to, if the weights are mapped;
+  // declared first so that it is unmapped after the reader is destroyed
+  std::unique_ptr<MappedFile> weights_file;
+  // the mapped weights were replaced by a copy in heap memory, for a plugin
+  // not known to copy them when the network is loaded
+  bool weights_copied = false;
+  InferenceEngine::CNNNetReader::Ptr net_reader;
+  std::vector<std::string> labels;
+  // serializes the models checking and setting the layer properties
+  std::mutex mutex;
+  // the files are read by the first model of the network
+  std::once_flag read_flag;
+};
+
+/**
+ * @struct SharedExecutableNetwork
+ * @brief A network loaded on a plugin, shared by all the engines created for
+ * the same network and plugin with the same configuration.
+ */
+struct SharedExecutableNetwork {
+  // keep the network and the plugin the registry key refers to alive
+  std::shared_ptr<SharedNetwork> network;
+  InferenceEngine::InferencePlugin plugin;
+  InferenceEngine::ExecutableNetwork executable_network;
+  // the network is loaded by the first engine
+  std::once_flag load_flag;
+};
+
+/**
+ * @class ModelRegistry
+ * @brief Process-wide registry of the networks read and loaded so far, so
+ * identical IR files are parsed once and loaded once per plugin however many
+ * models and engines use them. The registry only keeps weak references: a
+ * network is released when the last model or engine using it is destroyed.
+ * Different networks are read and loaded concurrently when asked for from
+ * different threads, the same network is read and loaded once.
+ */
+class ModelRegistry {
+ public:
+  /**
+   * @brief Get the registry of the process.
+   */
+  static ModelRegistry &getInstance();
+  /**
+   * @brief Get the network read from the given files, reading them if no
+   * model uses the network yet.
+   * @param[in] model_loc The location of model' s .xml file.
+   * @param[in] batch_size The batch size set to the network.
+   * @param[in] model_name The name of the model class, which sets the layer
+   * properties of the network.
+   * @param[in] map_weights Whether the weights are read through a memory
+   * mapping of the .bin file rather than into heap memory. The weights are
+   * read into heap memory if the file cannot be mapped, and copied there
+   * before the network is loaded on a plugin not known to copy them. Only
+   * used when the files are read, i.e. by the first model of a network.
+   * @return The shared network.
+   */
+  std::shared_ptr<SharedNetwork> getNetwork(const std::string &model_loc,
+                                            int batch_size,
+                                            const std::string &model_name,
+                                            bool map_weights = false);
+  /**
+   * @brief Get the network loaded on the given plugin, loading it if no
+   * engine uses it yet. Networks are loaded on a plugin one at a time, the
+   * plugins are not known to be thread-safe.
+   * @param[in] plugin The plugin of the target device.
+   * @param[in] network The network to be loaded.
+   * @param[in] config The configuration the network is loaded with.
+   * @return The shared executable network.
+   */
+  std::shared_ptr<SharedExecutableNetwork> getExecutableNetwork(
+      InferenceEngine::InferencePlugin plugin,
+      const std::shared_ptr<SharedNetwork> &network,
+      const std::map<std::string, std::string> &config = {});
+
+ private:
+  using NetworkKey = std::tuple<std::string, int, std::string>;
+  using ExecutableNetworkKey =
+      std::tuple<const void *, const void *,
+                 std::map<std::string, std::string>>;
+
+  ModelRegistry() = default;
+  void readNetwork(const std::string &model_loc, int batch_size,
+                   bool map_weights, SharedNetwork *network);
+  void copyWeights(SharedNetwork *network);
+  ModelRegistry(const ModelRegistry &) = delete;
+  ModelRegistry &operator=(const ModelRegistry &) = delete;
+
+  std::mutex mutex_;
+  std::map<NetworkKey, std::weak_ptr<SharedNetwork>> networks_;
+  std::map<ExecutableNetworkKey, std::weak_ptr<SharedExecutableNetwork>>
+      executable_networks_;
+  // serializes the loading of networks on each plugin
+  std::map<const void *, std::unique_ptr<std::mutex>> load_mutexes_;
+};
+}
+
+#endif //OPENVINO_PIPELINE_LIB_MODEL_REGISTRY_H
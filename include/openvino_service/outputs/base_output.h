@@ -11,14 +11,20 @@
 namespace Outputs {
 /**
  * @class BaseOutput
- * @brief This class is a base class for various output devices. It employs
- * visitor pattern to perform different operations to different inference
- * result with different output device
+ * @brief This class is a base class for various output devices. Each
+ * inference hands its results over as a ResultTable, whose rows are stored
+ * column by column, and the output device switches on the ResultKind of the
+ * table to handle the columns of that kind of inference.
  */
 class BaseOutput {
  public:
   BaseOutput() = default;
-  virtual void accept(const openvino_service::Result&) = 0;
+  /**
+   * @brief Take the results of one inference for the frame fed last. The
+   * kind of the table tells how to handle its rows.
+   * @param[in] results The results, valid until the call returns.
+   */
+  virtual void accept(const openvino_service::ResultTable &results) = 0;
   virtual void feedFrame(const cv::Mat &frame) {}
   virtual void handleOutput(const std::string &overall_output_text) = 0;
 };
@@ -7,6 +7,8 @@
 #define OPENVINO_PIPELINE_LIB_IMAGE_WINDOW_OUTPUT_H
 
 #include "openvino_service/outputs/base_output.h"
+#include "openvino_service/inferences/age_gender_recognition.h"
+#include "openvino_service/inferences/head_pose_recognition.h"
 
 namespace Outputs {
 
@@ -16,11 +18,22 @@ class ImageWindowOutput : public BaseOutput {
                              int focal_length = 950);
   void feedFrame(const cv::Mat &) override;
   void handleOutput(const std::string &overall_output_text) override;
-  void accept(const openvino_service::Result&) override ;
+  void accept(const openvino_service::ResultTable &results) override;
 
  private:
+  void decorateFaces(const openvino_service::ResultTable &results);
+  void decorateEmotions(const openvino_service::ResultTable &results);
+  void decorateAgeGender(const openvino_service::ResultTable &results);
+  void decorateHeadPoses(const openvino_service::ResultTable &results);
+  /**
+   * @brief Make frame_ a private copy before the first drawing on it, so the
+   * frame of the pipeline is only copied when it is decorated.
+   */
+  void makeFrameWritable();
+
   const std::string window_name_;
   cv::Mat frame_;
+  bool frame_writable_ = false;
   float focal_length_;
   cv::Mat camera_matrix_;
 };
@@ -8,25 +8,34 @@
 #include "openvino_service/inferences/base_inference.h"
 #include "openvino_service/inputs/standard_camera.h"
 #include "openvino_service/outputs/base_output.h"
+#include "openvino_service/profiler.h"
+#include "openvino_service/thread_pool.h"
 
 #include "opencv2/opencv.hpp"
 
 #include <memory>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <mutex>
 #include <future>
 
 /**
  * @class Pipeline
  * @brief This class is a pipeline class that stores the topology of 
- * the input device, output device and networks and make inference. One pipeline
- * should have only one input device.
+ * the input device, output device and networks and make inference. Several
+ * input devices can feed the same networks, sharing their engines and
+ * requests.
  */
 class Pipeline {
  public:
   Pipeline();
+  ~Pipeline();
   /**
-   * @brief Add input device to the pipeline.
+   * @brief Add input device to the pipeline. More input devices can be added
+   * under different names, each one is a stream of frames.
    * @param[in] name name of the current input device.
    * @param[in] input_device the input device instance to be added.
    * @return whether the add operation is successful
@@ -34,7 +43,9 @@ class Pipeline {
   bool add(const std::string &name,
            std::unique_ptr<Input::BaseInputDevice> input_device);
   /**
-   * @brief Add inference network to the pipeline.
+   * @brief Add inference network to the pipeline. If the network is already
+   * in the pipeline, only the edge from the parent is added. The engine of
+   * the inference must be loaded, e.g. by an Engines::EngineLoader.
    * @param[in] parent name of the parent device or inference.
    * @param[in] name name of the current inference network.
    * @param[in] inference the inference instance to be added.
@@ -52,42 +63,269 @@ class Pipeline {
   bool add(const std::string &parent, const std::string &name,
            std::shared_ptr<Outputs::BaseOutput> output);
   /**
-   * @brief Add inference network-output device edge to the pipeline.
-   * @param[in] parent name of the parent inference.
-   * @param[in] name name of the current output device.
+   * @brief Add inference network-output device edge to the pipeline, or an
+   * edge to an inference network already in the pipeline, e.g. to let it
+   * serve another input device.
+   * @param[in] parent name of the parent device or inference.
+   * @param[in] name name of the current output device or inference network.
    * @return whether the add operation is successful
    */              
   bool add(const std::string &parent, const std::string &name);
   /**
-   * @brief Do the inference once. 
+   * @brief Show the frames of the given input device on the output device.
+   * By default an output device receives the frames of all input devices,
+   * once routed it only receives the frames of the routed input devices.
+   * @param[in] output_name name of the output device.
+   * @param[in] input_name name of the input device.
+   * @return whether the route operation is successful
+   */
+  bool routeOutput(const std::string &output_name,
+                   const std::string &input_name);
+  /**
+   * @brief Set how many frames can be processed by the pipeline at the same
+   * time. With more than one frame in flight, the input device and the
+   * networks of different frames run concurrently, while the results still
+   * reach the output devices in the order the frames were read.
+   * @param[in] max_frames Maximum number of frames in flight (at least 1).
+   */
+  void setMaxInFlightFrames(size_t max_frames);
+  /**
+   * @brief Check the topology and compile it into an indexed graph: every
+   * device and network gets a dense integer id, and the edges become arrays
+   * of ids, so running frames never looks a node up by its name. Called by
+   * setCallback() and runOnce() if the topology changed since the last call.
+   * The topology must not change while frames are in flight, and
+   * setCallback() must be called again after it changed.
+   * @return Whether the topology is valid: the networks form no cycle.
+   */
+  bool compile();
+  /**
+   * @brief Do the inference once: read one frame from each input device.
    * Data flow from input device to inference network, then to output device.
+   * When more than one frame is allowed in flight, this function returns as
+   * soon as there is room for the next frame, and the outputs are fed with
+   * every frame that has finished in the meantime.
+   * An exception thrown while a worker handled a finished request is thrown
+   * again here, by this and every later call: the frames it concerned are
+   * finished without the results that failed, but the pipeline stops.
    */
   void runOnce();
   /**
-   * @brief The callback function provided for all the inference network in the pipeline.
+   * @brief Wait until all frames in flight are finished and feed them to the
+   * output devices. Throws the exception of a failed worker task, as
+   * runOnce() does.
+   */
+  void flush();
+  /**
+   * @brief Set the worker threads handling the finished requests. By default
+   * one worker fetches the results and starts the next networks, so the
+   * threads of the plugins return as soon as a request is finished; the jobs
+   * of each next network are started as separate tasks, so the next networks
+   * pack their inputs concurrently on several workers. Must be called before
+   * the first frame is run.
+   * @param[in] thread_num Number of worker threads, 0 to handle the finished
+   * requests on the threads of the plugins.
+   * @param[in] cpus CPUs the workers are pinned to, not pinned if empty.
    */
-  void callback(const std::string &detection_name);
+  void setWorkerThreads(size_t thread_num, const std::vector<int> &cpus = {});
   /**
    * @brief Set the inference network to call the callback function as soon as each inference is finished.
+   * The callback of each network hands its finished requests over to the
+   * worker threads by node id.
    */
   void setCallback();
   void printPipeline();
+  /**
+   * @brief Get the statistics of the pipeline: for each input device the
+   * read time and dropped frames, for each network the enqueue, inference,
+   * fetch and callback times, batch sizes and queue depth, for each output
+   * device the output time, and the latency of the frames. Nothing is
+   * recorded when the library is built without ENABLE_PROFILING.
+   * @return The profiler holding the statistics.
+   */
+  inline openvino_service::Profiler &getProfiler() { return profiler_; }
+  /**
+   * @brief Write the statistics periodically to a stream, from the thread
+   * calling runOnce().
+   * @param[in] interval Time between two dumps, 0 to disable them.
+   * @param[in] stream The stream to write to.
+   * @param[in] json Whether to write JSON instead of a table.
+   */
+  void setStatisticsDump(std::chrono::milliseconds interval,
+                         std::ostream *stream, bool json = false);
  private:
-  std::shared_ptr<Input::BaseInputDevice> input_device_;
-  std::string input_device_name_;
+  /**
+   * @brief State of one frame travelling through the pipeline.
+   */
+  struct FrameContext {
+    cv::Mat frame;
+    // node of the input device the frame comes from
+    int input_node = -1;
+    std::chrono::steady_clock::time_point read_time;
+    // number of inference jobs not finished yet for this frame
+    int pending = 0;
+    // results of the inferences followed by output devices, by result slot
+    std::vector<openvino_service::ResultTable> results;
+  };
+  /**
+   * @brief Input of one inference for one frame: the whole frame for the
+   * networks following the input device, or the locations found by the
+   * parent network otherwise.
+   */
+  struct InferenceJob {
+    std::shared_ptr<FrameContext> context;
+    std::vector<cv::Rect> locations;
+    bool whole_frame = false;
+  };
+  /**
+   * @brief Jobs put into the same request. Without batching policy a batch
+   * holds one job, otherwise the jobs of several frames can share a request.
+   */
+  using InferenceBatch = std::vector<InferenceJob>;
+  /**
+   * @brief Part of a submitted request belonging to one job.
+   */
+  struct BatchSegment {
+    std::shared_ptr<FrameContext> context;
+    // number of inputs of the job put into the request
+    size_t count = 0;
+  };
+  /**
+   * @brief Scheduling state of one inference. An inference works on as many
+   * batches at a time as its engine has requests, other batches wait in the
+   * queue.
+   */
+  struct InferenceState {
+    std::deque<InferenceBatch> queue;
+    // jobs collected by the batching policy, not scheduled yet
+    InferenceBatch batch;
+    size_t batch_size = 0;
+    std::chrono::steady_clock::time_point batch_deadline;
+    // jobs of the submitted requests, by request index
+    std::map<size_t, std::vector<BatchSegment>> running;
+    size_t active = 0;
+    // serializes enqueue/submit and fetch on the inference instance
+    std::mutex mutex;
+    // submit time of the running requests, by request index, only kept
+    // when profiling is enabled
+    std::map<size_t, std::chrono::steady_clock::time_point> submit_times;
+    openvino_service::Histogram *enqueue_time = nullptr;
+    openvino_service::Histogram *infer_time = nullptr;
+    openvino_service::Histogram *fetch_time = nullptr;
+    openvino_service::Histogram *callback_time = nullptr;
+    openvino_service::Histogram *batch_size_stats = nullptr;
+    openvino_service::Gauge *queue_depth = nullptr;
+  };
+  enum class NodeKind { INPUT, INFERENCE, OUTPUT };
+  /**
+   * @brief Node of the compiled graph, refering to its device or network
+   * and to the nodes following it by id.
+   */
+  struct Node {
+    NodeKind kind;
+    std::string name;
+    Input::BaseInputDevice *input = nullptr;
+    openvino_service::BaseInference *inference = nullptr;
+    Outputs::BaseOutput *output = nullptr;
+    InferenceState *state = nullptr;
+    size_t request_num = 0;
+    // inferences fed by an input device or an inference
+    std::vector<int> next_inferences;
+    // for an input device, the outputs showing its frames
+    std::vector<int> outputs;
+    // for an inference, the slot of its results in FrameContext::results,
+    // -1 if no output follows it
+    int result_slot = -1;
+    // for an output, the result slots it accepts, in inference name order
+    std::vector<int> result_slots;
+    // read time of an input device or output time of an output
+    openvino_service::Histogram *time = nullptr;
+    openvino_service::Gauge *dropped_frames = nullptr;
+  };
+
+  /**
+   * @brief Run a task on the worker threads, or at once without workers. An
+   * exception thrown by the task is kept for the thread running the frames.
+   */
+  void post(std::function<void()> task);
+  /**
+   * @brief Keep the first exception of a worker task and wake up the thread
+   * waiting for the frames.
+   */
+  void setError(std::exception_ptr error);
+  /**
+   * @brief Throw the kept exception, if any. Must be called with
+   * counter_mutex_ held by the lock, which is released before throwing.
+   */
+  void rethrowError(std::unique_lock<std::mutex> *lock);
+  void finishRequest(int node, size_t request_id);
+  void schedule(int node, InferenceJob job);
+  void dispatch(int node, InferenceBatch batch);
+  void startBatch(int node, const InferenceBatch &batch);
+  void finishBatch(int node, const std::vector<BatchSegment> &segments,
+                   int request_id);
+  /**
+   * @brief Take the collected batches whose deadline has passed, or all of
+   * them, with the node of their inference. Must be called with
+   * counter_mutex_ held.
+   */
+  std::vector<std::pair<int, InferenceBatch>> takeBatches(bool take_all);
+  /**
+   * @brief Start the collected batches which cannot wait any longer, then
+   * optionally wait until one of them expires or a request finishes.
+   * @param[in] lock The lock held on counter_mutex_.
+   * @param[in] wait Whether the caller waits for the pipeline to progress.
+   */
+  void progressBatches(std::unique_lock<std::mutex> *lock, bool wait);
+  void handleOutputs(FrameContext *context);
+  void waitForFrames(size_t max_frames);
+  void dumpStatistics();
+
+  std::map<std::string, std::shared_ptr<Input::BaseInputDevice>>
+      input_devices_;
+  // names of the input devices, in the order they are read
+  std::vector<std::string> input_device_names_;
+  // input devices routed to each output device, all of them if not present
+  std::map<std::string, std::set<std::string>> output_streams_;
   std::multimap<std::string, std::string> next_;
   std::map<std::string, std::shared_ptr<openvino_service::BaseInference>>
       name_to_detection_map_;
   std::map<std::string, std::shared_ptr<Outputs::BaseOutput>> name_to_output_map_;
   int total_inference_ = 0;
   std::set<std::string> output_names_;
-  int width_ = 0;
-  int height_ = 0;
-  cv::Mat frame_;
+  size_t max_in_flight_frames_ = 1;
+  // frames in flight in reading order, guarded by counter_mutex_
+  std::deque<std::shared_ptr<FrameContext>> frames_;
+  // finished frame contexts kept for reuse with their result tables
+  std::vector<std::shared_ptr<FrameContext>> free_contexts_;
+  std::map<std::string, InferenceState> inference_states_;
+  // compiled graph, nodes of the input devices in reading order
+  std::vector<Node> nodes_;
+  std::vector<int> input_nodes_;
+  std::vector<int> inference_nodes_;
+  size_t result_slot_num_ = 0;
+  bool compiled_ = false;
   // for multi threads
-  std::atomic<int> counter_;
   std::mutex counter_mutex_;
   std::condition_variable cv_;
+  // first exception of a worker task, guarded by counter_mutex_
+  std::exception_ptr error_;
+  // tasks posted and not finished yet, guarded by counter_mutex_
+  size_t posted_tasks_ = 0;
+  // statistics, metrics of the nodes are created when they are added
+  openvino_service::Profiler profiler_;
+  std::map<std::string, openvino_service::Histogram *> read_times_;
+  std::map<std::string, openvino_service::Gauge *> dropped_frames_;
+  std::map<std::string, openvino_service::Histogram *> output_times_;
+  openvino_service::Histogram *frame_latency_;
+  openvino_service::Gauge *frames_in_flight_;
+  std::chrono::milliseconds dump_interval_{0};
+  std::ostream *dump_stream_ = nullptr;
+  bool dump_json_ = false;
+  std::chrono::steady_clock::time_point next_dump_;
+  // declared last, so the workers finish their tasks before the state they
+  // use is destroyed
+  std::unique_ptr<openvino_service::ThreadPool> workers_;
 };
 
 #endif //SAMPLES_PIPELINE_H
@@ -0,0 +1,184 @@
+/**
+ * @brief A header file with declaration for Profiler Class
+ * @file profiler.h
+ */
+#ifndef OPENVINO_PIPELINE_LIB_PROFILER_H
+#define OPENVINO_PIPELINE_LIB_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace openvino_service {
+/**
+ * @class Histogram
+ * @brief Lock-free histogram of non-negative values (e.g. microseconds), with
+ * four buckets per power of two, so percentiles are estimated within 25%.
+ */
+class Histogram {
+ public:
+  Histogram();
+  /**
+   * @brief Add a value to the histogram. Safe to call from any thread.
+   */
+  void record(uint64_t value);
+  inline uint64_t getCount() const { return count_.load(); }
+  inline uint64_t getMax() const { return max_.load(); }
+  double getMean() const;
+  /**
+   * @brief Estimate a percentile of the recorded values.
+   * @param[in] quantile The quantile, between 0 and 1 (e.g. 0.99).
+   * @return The upper bound of the bucket holding the percentile.
+   */
+  uint64_t getPercentile(double quantile) const;
+  void reset();
+
+ private:
+  static const size_t kBuckets = 256;
+  static size_t bucketOf(uint64_t value);
+  static uint64_t bucketUpperBound(size_t bucket);
+
+  std::array<std::atomic<uint64_t>, kBuckets> buckets_;
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> max_{0};
+};
+
+/**
+ * @class Gauge
+ * @brief Current value of a quantity (e.g. a queue depth) and its maximum.
+ */
+class Gauge {
+ public:
+  void set(int64_t value);
+  void add(int64_t delta);
+  inline int64_t getValue() const { return value_.load(); }
+  inline int64_t getMax() const { return max_.load(); }
+  void reset();
+
+ private:
+  void raiseMax(int64_t value);
+
+  std::atomic<int64_t> value_{0};
+  std::atomic<int64_t> max_{0};
+};
+
+/**
+ * @class ScopedTimer
+ * @brief Record the lifetime of the object into a histogram, in microseconds.
+ */
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(Histogram *histogram)
+      : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+  ~ScopedTimer() {
+    histogram_->record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start_).count()));
+  }
+
+ private:
+  Histogram *histogram_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @class Profiler
+ * @brief Named histograms and gauges of the nodes of a pipeline. Metrics are
+ * created once when the pipeline is built; recording into them afterwards
+ * takes no lock.
+ */
+class Profiler {
+ public:
+  /**
+   * @brief Summary of one histogram.
+   */
+  struct HistogramStats {
+    std::string node;
+    std::string metric;
+    uint64_t count;
+    double mean;
+    uint64_t p50;
+    uint64_t p95;
+    uint64_t p99;
+    uint64_t max;
+  };
+  /**
+   * @brief Summary of one gauge.
+   */
+  struct GaugeStats {
+    std::string node;
+    std::string metric;
+    int64_t value;
+    int64_t max;
+  };
+  Profiler();
+  /**
+   * @brief Get the histogram of a metric of a node, created if needed.
+   * The pointer stays valid as long as the profiler.
+   */
+  Histogram *getHistogram(const std::string &node, const std::string &metric);
+  /**
+   * @brief Get the gauge of a metric of a node, created if needed.
+   * The pointer stays valid as long as the profiler.
+   */
+  Gauge *getGauge(const std::string &node, const std::string &metric);
+  std::vector<HistogramStats> getHistogramStats() const;
+  std::vector<GaugeStats> getGaugeStats() const;
+  /**
+   * @brief Get the time elapsed since the profiler was created or reset.
+   */
+  double getElapsedSeconds() const;
+  /**
+   * @brief Format the statistics as a table.
+   */
+  std::string toText() const;
+  /**
+   * @brief Format the statistics as a JSON object.
+   */
+  std::string toJson() const;
+  /**
+   * @brief Clear all the recorded values.
+   */
+  void reset();
+
+ private:
+  using Key = std::pair<std::string, std::string>;
+  mutable std::mutex mutex_;
+  std::map<Key, std::unique_ptr<Histogram>> histograms_;
+  std::map<Key, std::unique_ptr<Gauge>> gauges_;
+  std::chrono::steady_clock::time_point start_;
+};
+}
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef ENABLE_PROFILING
+/**
+ * @brief Record the time spent in the enclosing scope into a histogram.
+ */
+#define PROFILE_SCOPE(histogram) \
+  openvino_service::ScopedTimer PROFILE_CONCAT(profile_scope_, __LINE__)( \
+      histogram)
+/**
+ * @brief Record a value into a histogram.
+ */
+#define PROFILE_RECORD(histogram, value) (histogram)->record(value)
+/**
+ * @brief Set the value of a gauge.
+ */
+#define PROFILE_SET(gauge, value) (gauge)->set(value)
+#else
+#define PROFILE_SCOPE(histogram)
+#define PROFILE_RECORD(histogram, value)
+#define PROFILE_SET(gauge, value)
+#endif
+
+#endif //OPENVINO_PIPELINE_LIB_PROFILER_H
@@ -0,0 +1,67 @@
+/**
+ * @brief A header file with declaration for ThreadPool Class
+ * @file thread_pool.h
+ */
+#ifndef OPENVINO_PIPELINE_LIB_THREAD_POOL_H
+#define OPENVINO_PIPELINE_LIB_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace openvino_service {
+/**
+ * @class ThreadPool
+ * @brief Work-stealing thread pool. Each worker has its own queue: a task
+ * submitted by a worker goes to the queue of that worker, and idle workers
+ * steal from the other queues. Every queue is run oldest task first, so the
+ * tasks of a frame are not overtaken by the ones of later frames. Tasks
+ * submitted from other threads are spread over the queues.
+ */
+class ThreadPool {
+ public:
+  /**
+   * @param[in] thread_num The number of worker threads (at least 1).
+   * @param[in] cpus CPUs the workers are pinned to, worker i runs on
+   * cpus[i % cpus.size()]. Not pinned if empty.
+   */
+  explicit ThreadPool(size_t thread_num, const std::vector<int> &cpus = {});
+  /**
+   * @brief Run the tasks still queued, then stop the workers.
+   */
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  /**
+   * @brief Queue a task, safe to call from any thread including the workers.
+   * An exception thrown by the task is logged and dropped.
+   */
+  void submit(std::function<void()> task);
+  inline const size_t getThreadNum() const { return threads_.size(); }
+
+ private:
+  struct WorkerQueue {
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+  };
+  bool popTask(size_t index, std::function<void()> *task);
+  void run(size_t index);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> threads_;
+  // number of queued tasks, changed under mutex_ when it grows so that no
+  // wake-up is lost
+  std::atomic<size_t> queued_{0};
+  std::atomic<size_t> next_queue_{0};
+  bool stopping_ = false;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+}
+
+#endif //OPENVINO_PIPELINE_LIB_THREAD_POOL_H
@@ -4,9 +4,69 @@
  */
 #include "openvino_service/engines/engine.h"
 
+#include <cstring>
+
 Engines::Engine::Engine(
     InferenceEngine::InferencePlugin plg,
-    const Models::BaseModel::Ptr base_model) {
-  request_ = (plg.LoadNetwork(base_model->net_reader_->getNetwork(), {}))
-      .CreateInferRequestPtr();
-};
\ No newline at end of file
+    const Models::BaseModel::Ptr base_model,
+    size_t request_num) {
+  if (!base_model->network_) {
+    throw std::logic_error(base_model->getModelName() +
+                           " is not initialized by modelInit()");
+  }
+  executable_network_ = Models::ModelRegistry::getInstance()
+      .getExecutableNetwork(plg, base_model->network_);
+  for (auto &input : base_model->network_->net_reader->getNetwork()
+      .getInputsInfo()) {
+    input_names_.push_back(input.first);
+  }
+  if (request_num == 0) {
+    request_num = 1;
+  }
+  for (size_t i = 0; i < request_num; ++i) {
+    requests_.push_back(
+        executable_network_->executable_network.CreateInferRequestPtr());
+    free_requests_.push_back(i);
+  }
+};
+
+Engines::Engine::Engine(size_t request_num) {
+  if (request_num == 0) {
+    request_num = 1;
+  }
+  for (size_t i = 0; i < request_num; ++i) {
+    requests_.push_back(nullptr);
+    free_requests_.push_back(i);
+  }
+}
+
+size_t Engines::Engine::acquireRequest() {
+  std::unique_lock<std::mutex> lock(requests_mutex_);
+  requests_cv_.wait(lock, [self = this]() {
+    return !self->free_requests_.empty();
+  });
+  size_t request_id = free_requests_.front();
+  free_requests_.pop_front();
+  return request_id;
+}
+
+void Engines::Engine::releaseRequest(size_t request_id) {
+  {
+    std::lock_guard<std::mutex> lock(requests_mutex_);
+    free_requests_.push_back(request_id);
+  }
+  requests_cv_.notify_one();
+}
+
+void Engines::Engine::warmUp(size_t iterations) {
+  for (auto &request : requests_) {
+    if (request == nullptr) continue;
+    for (auto &input_name : input_names_) {
+      InferenceEngine::Blob::Ptr blob = request->GetBlob(input_name);
+      std::memset(blob->buffer().as<uint8_t *>(), 0, blob->byteSize());
+    }
+    for (size_t i = 0; i < iterations; ++i) {
+      request->Infer();
+    }
+  }
+}
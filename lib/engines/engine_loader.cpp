@@ -0,0 +1,92 @@
+/**
+ * @brief a header file with definition of EngineLoader class
+ * @file engine_loader.cpp
+ */
+#include "openvino_service/engines/engine_loader.h"
+
+#include <chrono>
+#include <exception>
+#include <stdexcept>
+
+#include "openvino_service/slog.hpp"
+
+namespace {
+double getMilliseconds(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - start).count();
+}
+}
+
+Engines::EngineLoader::~EngineLoader() {
+  // the tasks still running use the members of the loader
+  for (auto &future : futures_) {
+    if (future.valid()) {
+      future.wait();
+    }
+  }
+}
+
+size_t Engines::EngineLoader::add(std::shared_ptr<Models::BaseModel> model,
+                                  InferenceEngine::InferencePlugin plugin,
+                                  size_t request_num) {
+  if (started_) {
+    throw std::logic_error("Models cannot be added to a started loader");
+  }
+  tasks_.push_back({std::move(model), plugin, request_num, nullptr});
+  return tasks_.size() - 1;
+}
+
+void Engines::EngineLoader::start(size_t warm_up_iterations) {
+  if (started_) {
+    return;
+  }
+  started_ = true;
+  timings_.resize(tasks_.size());
+  for (size_t i = 0; i < tasks_.size(); ++i) {
+    futures_.push_back(std::async(std::launch::async,
+                                  &EngineLoader::load, this, i,
+                                  warm_up_iterations));
+  }
+}
+
+void Engines::EngineLoader::load(size_t index, size_t warm_up_iterations) {
+  Task &task = tasks_[index];
+  Timings &timings = timings_[index];
+  timings.name = task.model->getModelName();
+  auto start = std::chrono::steady_clock::now();
+  task.model->modelInit();
+  timings.load_ms = getMilliseconds(start);
+  start = std::chrono::steady_clock::now();
+  task.engine = std::make_shared<Engine>(task.plugin, task.model,
+                                         task.request_num);
+  timings.compile_ms = getMilliseconds(start);
+  start = std::chrono::steady_clock::now();
+  task.engine->warmUp(warm_up_iterations);
+  timings.warm_up_ms = getMilliseconds(start);
+}
+
+void Engines::EngineLoader::wait() {
+  start();
+  // wait for all tasks before reporting the first error
+  for (auto &future : futures_) {
+    if (!future.valid()) {
+      continue;
+    }
+    try {
+      future.get();
+    } catch (...) {
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+  }
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+std::shared_ptr<Engines::Engine>
+Engines::EngineLoader::getEngine(size_t index) {
+  wait();
+  return tasks_.at(index).engine;
+}
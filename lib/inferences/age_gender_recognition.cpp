@@ -1,30 +1,9 @@
 /**
- * @brief a header file with declaration of AgeGenderResult class
+ * @brief a header file with declaration of AgeGenderDetection class
  * @file age_gender_recognition.cpp
  */
 #include "openvino_service/inferences/age_gender_recognition.h"
 
-//AgeGenderResult
-openvino_service::AgeGenderResult::AgeGenderResult(
-    const cv::Rect &location) : Result(location){};
-
-void openvino_service::AgeGenderResult::decorateFrame(
-    cv::Mat *frame, cv::Mat *camera_matrix) const {
-  std::ostringstream out;
-  cv::Rect rect = getLocation();
-
-  out.str("");
-  out << "Age: " << age_ << "," <<
-      "Gender: " << ((male_prob_ > 0.5)?"Male":"Female");
-  cv::putText(*frame,
-              out.str(),
-              cv::Point2f(rect.x, rect.y-5),
-              cv::FONT_HERSHEY_COMPLEX_SMALL,
-              0.8,
-              cv::Scalar(0, 255, 0));
-  cv::rectangle(*frame, rect, cv::Scalar(100, 100, 100), 1);
-}
-
 // AgeGender Detection
 openvino_service::AgeGenderDetection::AgeGenderDetection()
     : openvino_service::BaseInference() {};
@@ -34,20 +13,22 @@ openvino_service::AgeGenderDetection::~AgeGenderDetection() = default;
 void openvino_service::AgeGenderDetection::loadNetwork(
     std::shared_ptr<Models::AgeGenderDetectionModel> network) {
   valid_model_ = network;
+  getResultTable() = ResultTable(ResultKind::AGE_GENDER, ATTRIBUTE_COUNT);
   setMaxBatchSize(network->getMaxBatchSize());
 }
 
 bool openvino_service::AgeGenderDetection::enqueue(
     const cv::Mat &frame,
     const cv::Rect &input_frame_loc) {
-  if (getEnqueuedNum() == 0) { results_.clear(); }
-  bool succeed = openvino_service::BaseInference::enqueue<float>(
-      frame, input_frame_loc, 1, getResultsLength(),
+  return openvino_service::BaseInference::enqueue<float>(
+      frame, input_frame_loc, 1, getEnqueuedNum(),
       valid_model_->getInputName());
-  if (!succeed ) return false;
-  Result r(input_frame_loc);
-  results_.emplace_back(r);
-  return true;
+}
+
+size_t openvino_service::AgeGenderDetection::enqueueRegions(
+    const cv::Mat &frame, const std::vector<cv::Rect> &input_frame_locs) {
+  return openvino_service::BaseInference::enqueueRegions<float>(
+      frame, input_frame_locs, 1, valid_model_->getInputName());
 }
 
 bool openvino_service::AgeGenderDetection::submitRequest() {
@@ -57,28 +38,26 @@ bool openvino_service::AgeGenderDetection::submitRequest() {
 bool openvino_service::AgeGenderDetection::fetchResults() {
   bool can_fetch = openvino_service::BaseInference::fetchResults();
   if (!can_fetch) return false;
-  auto request = getEngine()->getRequest();
+  ResultTable &results = getResultTable();
+  results.clear();
+  for (auto &location : getFinishedLocations()) {
+    results.addRow(location);
+  }
+  auto request = getFinishedRequest();
   InferenceEngine::Blob::Ptr
       genderBlob = request->GetBlob(valid_model_->getOutputGenderName());
   InferenceEngine::Blob::Ptr
       ageBlob = request->GetBlob(valid_model_->getOutputAgeName());
 
-  for (int i = 0; i < results_.size(); ++i) {
-    results_[i].age_ = ageBlob->buffer().as<float *>()[i] * 100;
-    results_[i].male_prob_ = genderBlob->buffer().as<float *>()[i * 2 + 1];
+  const float *ages = ageBlob->buffer().as<float *>();
+  const float *genders = genderBlob->buffer().as<float *>();
+  for (size_t i = 0; i < results.size(); ++i) {
+    results.setAttribute(i, AGE, ages[i] * 100);
+    results.setAttribute(i, MALE_PROB, genders[i * 2 + 1]);
   }
   return true;
 };
 
-const int openvino_service::AgeGenderDetection::getResultsLength() const {
-  return (int)results_.size();
-};
-
-const openvino_service::Result*
-openvino_service::AgeGenderDetection::getLocationResult(int idx) const {
-  return &(results_[idx]);
-};
-
 const std::string openvino_service::AgeGenderDetection::getName() const {
   return valid_model_->getModelName();
 };
\ No newline at end of file
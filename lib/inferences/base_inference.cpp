@@ -4,11 +4,6 @@
  */
 #include "openvino_service/inferences/base_inference.h"
 
-//Result
-openvino_service::Result::Result(const cv::Rect &location) {
-  location_ = location;
-}
-
 //BaseInference
 openvino_service::BaseInference::BaseInference() = default;
 
@@ -17,19 +12,89 @@ openvino_service::BaseInference::~BaseInference() = default;
 void openvino_service::BaseInference::loadEngine(
     const std::shared_ptr<Engines::Engine> engine) {
   engine_ = engine;
+  request_locations_.assign(engine_->getRequestNum(), {});
 };
 
-bool openvino_service::BaseInference::submitRequest() {
-  if (engine_->getRequest() == nullptr) return false;
-  if (!enqueued_frames) return false;
+void openvino_service::BaseInference::setBatchingPolicy(
+    bool enabled, std::chrono::microseconds max_delay) {
+  batching_enabled_ = enabled;
+  batching_delay_ = max_delay;
+}
+
+size_t openvino_service::BaseInference::enqueueRegions(
+    const cv::Mat &frame, const std::vector<cv::Rect> &input_frame_locs) {
+  const cv::Rect frame_rect(0, 0, frame.cols, frame.rows);
+  size_t count = 0;
+  for (auto &location : input_frame_locs) {
+    if (!enqueue(frame(location & frame_rect), location)) break;
+    ++count;
+  }
+  return count;
+}
+
+int openvino_service::BaseInference::reserveSlot(
+    const cv::Rect &input_frame_loc) {
+  if (enqueued_frames == max_batch_size_) {
+    slog::warn << "Number of " << getName() <<
+               "input more than maximum("
+               << max_batch_size_
+               << ") processed by inference" << slog::endl;
+    return -1;
+  }
+  if (enqueued_frames == 0) {
+    enqueue_request_ = static_cast<int>(engine_->acquireRequest());
+    request_locations_[enqueue_request_].clear();
+  }
+  request_locations_[enqueue_request_].push_back(input_frame_loc);
+  return enqueued_frames++;
+}
+
+int openvino_service::BaseInference::takeEnqueuedRequest() {
+  if (enqueue_request_ < 0 || !enqueued_frames) return -1;
+  int request_id = enqueue_request_;
   enqueued_frames = 0;
-  results_fetched_ = false;
-  engine_->getRequest()->StartAsync();
+  enqueue_request_ = -1;
+  return request_id;
+}
+
+void openvino_service::BaseInference::discardEnqueuedRequest() {
+  if (enqueue_request_ < 0) return;
+  size_t request_id = static_cast<size_t>(enqueue_request_);
+  enqueued_frames = 0;
+  enqueue_request_ = -1;
+  engine_->releaseRequest(request_id);
+}
+
+bool openvino_service::BaseInference::submitRequest() {
+  if (enqueue_request_ < 0) return false;
+  auto request = engine_->getRequest(enqueue_request_);
+  if (request == nullptr || enqueued_frames == 0) {
+    discardEnqueuedRequest();
+    return false;
+  }
+  int request_id = takeEnqueuedRequest();
+  try {
+    request->StartAsync();
+  } catch (...) {
+    engine_->releaseRequest(static_cast<size_t>(request_id));
+    throw;
+  }
   return true;
 }
 
+void openvino_service::BaseInference::setFinishedRequest(size_t request_id) {
+  finished_request_ = static_cast<int>(request_id);
+  results_fetched_ = false;
+}
+
+void openvino_service::BaseInference::releaseFinishedRequest() {
+  if (finished_request_ < 0) return;
+  engine_->releaseRequest(static_cast<size_t>(finished_request_));
+  finished_request_ = -1;
+}
+
 bool openvino_service::BaseInference::fetchResults() {
-  if (results_fetched_) return false;
+  if (results_fetched_ || finished_request_ < 0) return false;
   results_fetched_ = true;
   return true;
 }
\ No newline at end of file
@@ -0,0 +1,194 @@
+/**
+ * @brief a header file with definition of the blob packing functions
+ * @file blob_packer.cpp
+ */
+#include "openvino_service/inferences/blob_packer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "blob_packer_kernels.h"
+
+namespace {
+
+/**
+ * @brief Row kernels of one ISA level.
+ */
+struct PackerKernels {
+  void (*pack_u8)(const uint8_t *, size_t, uint8_t *, uint8_t *, uint8_t *);
+  void (*pack_f32)(const uint8_t *, size_t, float, float *, float *, float *);
+};
+
+/**
+ * @brief Kernels of the highest level the CPU supports, checked once.
+ */
+const PackerKernels &getKernels() {
+  static const PackerKernels kernels = []() -> PackerKernels {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+      return {openvino_service::packer_AVX512F::packRow,
+              openvino_service::packer_AVX512F::packRow};
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+      return {openvino_service::packer_AVX2::packRow,
+              openvino_service::packer_AVX2::packRow};
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+      return {openvino_service::packer_SSE42::packRow,
+              openvino_service::packer_SSE42::packRow};
+    }
+#endif
+    return {openvino_service::packer_ANY::packRow,
+            openvino_service::packer_ANY::packRow};
+  }();
+  return kernels;
+}
+
+/**
+ * @brief Source coordinate and weight of the second sample for output
+ * coordinate dst_pos, following the pixel center convention of cv::resize.
+ */
+inline void linearCoordinate(size_t dst_pos, float ratio, size_t src_size,
+                             int *first, float *weight) {
+  float pos = (dst_pos + 0.5f) * ratio - 0.5f;
+  int index = static_cast<int>(std::floor(pos));
+  float w = pos - index;
+  if (index < 0) {
+    index = 0;
+    w = 0;
+  }
+  if (index >= static_cast<int>(src_size) - 1) {
+    index = static_cast<int>(src_size) - 1;
+    w = 0;
+  }
+  *first = index;
+  *weight = w;
+}
+
+/**
+ * @brief Interpolate one source row horizontally into planar floats.
+ */
+inline void interpolateRow(const uint8_t *row, size_t width,
+                           const openvino_service::ResizeBuffer &buffer,
+                           float *dst) {
+  float *dst_b = dst;
+  float *dst_g = dst + width;
+  float *dst_r = dst + 2 * width;
+  for (size_t w = 0; w < width; w++) {
+    const uint8_t *left = row + buffer.x_left[w];
+    const uint8_t *right = row + buffer.x_right[w];
+    const float a = buffer.x_weights[w];
+    dst_b[w] = left[0] + (right[0] - left[0]) * a;
+    dst_g[w] = left[1] + (right[1] - left[1]) * a;
+    dst_r[w] = left[2] + (right[2] - left[2]) * a;
+  }
+}
+
+inline void storeValue(float value, float scale_factor, float *dst) {
+  *dst = value * scale_factor;
+}
+
+inline void storeValue(float value, float scale_factor, uint8_t *dst) {
+  value = value * scale_factor + 0.5f;
+  *dst = static_cast<uint8_t>(std::min(std::max(value, 0.f), 255.f));
+}
+
+}
+
+template<typename T>
+void openvino_service::resizeBGRToPlanar(const uint8_t *src, size_t src_step,
+                                         size_t src_width, size_t src_height,
+                                         size_t width, size_t height,
+                                         T *dst, float scale_factor,
+                                         ResizeBuffer *buffer) {
+  if (src_width == width && src_height == height) {
+    packBGRToPlanar(src, src_step, width, height, dst, scale_factor);
+    return;
+  }
+  const float x_ratio = static_cast<float>(src_width) / width;
+  const float y_ratio = static_cast<float>(src_height) / height;
+  buffer->x_left.resize(width);
+  buffer->x_right.resize(width);
+  buffer->x_weights.resize(width);
+  for (size_t w = 0; w < width; w++) {
+    int x;
+    linearCoordinate(w, x_ratio, src_width, &x, &buffer->x_weights[w]);
+    buffer->x_left[w] = x * 3;
+    buffer->x_right[w] = std::min(x + 1, static_cast<int>(src_width) - 1) * 3;
+  }
+  for (auto &row : buffer->rows) {
+    row.resize(3 * width);
+  }
+  buffer->row_index[0] = buffer->row_index[1] = -1;
+
+  const size_t plane_size = width * height;
+  for (size_t h = 0; h < height; h++) {
+    int y0;
+    float b;
+    linearCoordinate(h, y_ratio, src_height, &y0, &b);
+    int y1 = std::min(y0 + 1, static_cast<int>(src_height) - 1);
+    // consecutive output rows mostly share source rows, keep the ones
+    // already interpolated
+    if (buffer->row_index[1] == y0) {
+      std::swap(buffer->rows[0], buffer->rows[1]);
+      std::swap(buffer->row_index[0], buffer->row_index[1]);
+    }
+    if (buffer->row_index[0] != y0) {
+      interpolateRow(src + y0 * src_step, width, *buffer,
+                     buffer->rows[0].data());
+      buffer->row_index[0] = y0;
+    }
+    if (buffer->row_index[1] != y1) {
+      interpolateRow(src + y1 * src_step, width, *buffer,
+                     buffer->rows[1].data());
+      buffer->row_index[1] = y1;
+    }
+    const float *top = buffer->rows[0].data();
+    const float *bottom = buffer->rows[1].data();
+    for (size_t c = 0; c < 3; c++) {
+      T *dst_row = dst + c * plane_size + h * width;
+      const float *top_row = top + c * width;
+      const float *bottom_row = bottom + c * width;
+      for (size_t w = 0; w < width; w++) {
+        storeValue(top_row[w] + (bottom_row[w] - top_row[w]) * b,
+                   scale_factor, dst_row + w);
+      }
+    }
+  }
+}
+
+template void openvino_service::resizeBGRToPlanar<uint8_t>(
+    const uint8_t *, size_t, size_t, size_t, size_t, size_t,
+    uint8_t *, float, ResizeBuffer *);
+template void openvino_service::resizeBGRToPlanar<float>(
+    const uint8_t *, size_t, size_t, size_t, size_t, size_t,
+    float *, float, ResizeBuffer *);
+
+void openvino_service::packBGRToPlanar(const uint8_t *src, size_t src_step,
+                                       size_t width, size_t height,
+                                       uint8_t *dst, float scale_factor) {
+  if (scale_factor != 1.0f) {
+    packBGRToPlanar<uint8_t>(src, src_step, width, height, dst, scale_factor);
+    return;
+  }
+  const size_t plane_size = width * height;
+  const auto pack = getKernels().pack_u8;
+  for (size_t h = 0; h < height; h++) {
+    uint8_t *dst_b = dst + h * width;
+    pack(src + h * src_step, width, dst_b, dst_b + plane_size,
+         dst_b + 2 * plane_size);
+  }
+}
+
+void openvino_service::packBGRToPlanar(const uint8_t *src, size_t src_step,
+                                       size_t width, size_t height,
+                                       float *dst, float scale_factor) {
+  const size_t plane_size = width * height;
+  const auto pack = getKernels().pack_f32;
+  for (size_t h = 0; h < height; h++) {
+    float *dst_b = dst + h * width;
+    pack(src + h * src_step, width, scale_factor, dst_b, dst_b + plane_size,
+         dst_b + 2 * plane_size);
+  }
+}
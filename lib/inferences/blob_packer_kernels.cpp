@@ -0,0 +1,139 @@
+/**
+ * @brief a header file with definition of the row kernels of the blob
+ * packing functions, built once per ISA level named by PACKER_ISA
+ * @file blob_packer_kernels.cpp
+ */
+#include "blob_packer_kernels.h"
+
+#if defined(HAVE_SSE) || defined(HAVE_AVX2) || defined(HAVE_AVX512F)
+#include <immintrin.h>
+#endif
+
+#if !defined(PACKER_ISA)
+#define PACKER_ISA ANY
+#endif
+#define PACKER_CONCAT_(a, b) a##b
+#define PACKER_CONCAT(a, b) PACKER_CONCAT_(a, b)
+#define PACKER_NAMESPACE PACKER_CONCAT(packer_, PACKER_ISA)
+
+namespace {
+
+#if defined(HAVE_SSE) || defined(HAVE_AVX2) || defined(HAVE_AVX512F)
+// number of pixels handled by one iteration of the vector loops
+constexpr size_t kBlockPixels = 16;
+
+/**
+ * @brief Split 16 interleaved BGR pixels (48 bytes) into one vector per
+ * channel with byte shuffles.
+ */
+inline void deinterleaveBGR(const uint8_t *src,
+                            __m128i *b, __m128i *g, __m128i *r) {
+  const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+  const __m128i v1 =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 16));
+  const __m128i v2 =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 32));
+
+  const __m128i b0 = _mm_setr_epi8(
+      0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m128i b1 = _mm_setr_epi8(
+      -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1);
+  const __m128i b2 = _mm_setr_epi8(
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13);
+  const __m128i g0 = _mm_setr_epi8(
+      1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m128i g1 = _mm_setr_epi8(
+      -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1);
+  const __m128i g2 = _mm_setr_epi8(
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14);
+  const __m128i r0 = _mm_setr_epi8(
+      2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+  const __m128i r1 = _mm_setr_epi8(
+      -1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1);
+  const __m128i r2 = _mm_setr_epi8(
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15);
+
+  *b = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, b0),
+                                 _mm_shuffle_epi8(v1, b1)),
+                    _mm_shuffle_epi8(v2, b2));
+  *g = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, g0),
+                                 _mm_shuffle_epi8(v1, g1)),
+                    _mm_shuffle_epi8(v2, g2));
+  *r = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v0, r0),
+                                 _mm_shuffle_epi8(v1, r1)),
+                    _mm_shuffle_epi8(v2, r2));
+}
+
+/**
+ * @brief Convert 16 unsigned bytes to floats, scale and store them.
+ */
+inline void storeScaled(__m128i v, float scale_factor, float *dst) {
+#if defined(HAVE_AVX512F)
+  // zero-masked conversions, the unmasked ones trip -Wmaybe-uninitialized
+  // in the GCC intrinsic headers
+  const __m512 scale = _mm512_set1_ps(scale_factor);
+  const __mmask16 all = 0xFFFF;
+  _mm512_storeu_ps(dst, _mm512_mul_ps(
+      _mm512_maskz_cvtepi32_ps(all, _mm512_maskz_cvtepu8_epi32(all, v)),
+      scale));
+#elif defined(HAVE_AVX2)
+  const __m256 scale = _mm256_set1_ps(scale_factor);
+  _mm256_storeu_ps(dst, _mm256_mul_ps(
+      _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v)), scale));
+  _mm256_storeu_ps(dst + 8, _mm256_mul_ps(
+      _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(v, 8))), scale));
+#else
+  const __m128 scale = _mm_set1_ps(scale_factor);
+  _mm_storeu_ps(dst, _mm_mul_ps(
+      _mm_cvtepi32_ps(_mm_cvtepu8_epi32(v)), scale));
+  _mm_storeu_ps(dst + 4, _mm_mul_ps(
+      _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 4))), scale));
+  _mm_storeu_ps(dst + 8, _mm_mul_ps(
+      _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 8))), scale));
+  _mm_storeu_ps(dst + 12, _mm_mul_ps(
+      _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_srli_si128(v, 12))), scale));
+#endif
+}
+#endif
+
+}
+
+void openvino_service::PACKER_NAMESPACE::packRow(
+    const uint8_t *row, size_t width,
+    uint8_t *dst_b, uint8_t *dst_g, uint8_t *dst_r) {
+  size_t w = 0;
+#if defined(HAVE_SSE) || defined(HAVE_AVX2) || defined(HAVE_AVX512F)
+  for (; w + kBlockPixels <= width; w += kBlockPixels) {
+    __m128i b, g, r;
+    deinterleaveBGR(row + w * 3, &b, &g, &r);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_b + w), b);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_g + w), g);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_r + w), r);
+  }
+#endif
+  for (; w < width; w++) {
+    dst_b[w] = row[w * 3];
+    dst_g[w] = row[w * 3 + 1];
+    dst_r[w] = row[w * 3 + 2];
+  }
+}
+
+void openvino_service::PACKER_NAMESPACE::packRow(
+    const uint8_t *row, size_t width, float scale_factor,
+    float *dst_b, float *dst_g, float *dst_r) {
+  size_t w = 0;
+#if defined(HAVE_SSE) || defined(HAVE_AVX2) || defined(HAVE_AVX512F)
+  for (; w + kBlockPixels <= width; w += kBlockPixels) {
+    __m128i b, g, r;
+    deinterleaveBGR(row + w * 3, &b, &g, &r);
+    storeScaled(b, scale_factor, dst_b + w);
+    storeScaled(g, scale_factor, dst_g + w);
+    storeScaled(r, scale_factor, dst_r + w);
+  }
+#endif
+  for (; w < width; w++) {
+    dst_b[w] = row[w * 3] * scale_factor;
+    dst_g[w] = row[w * 3 + 1] * scale_factor;
+    dst_r[w] = row[w * 3 + 2] * scale_factor;
+  }
+}
@@ -0,0 +1,30 @@
+/**
+ * @brief A header file with declaration for the row kernels of the blob
+ * packing functions, built once per ISA level.
+ * @file blob_packer_kernels.h
+ */
+#ifndef OPENVINO_PIPELINE_LIB_BLOB_PACKER_KERNELS_H
+#define OPENVINO_PIPELINE_LIB_BLOB_PACKER_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Each build of the kernels has its own namespace, so that the builds do not
+// share symbols. The kernels use no inline function or template with external
+// linkage, which the linker could take from the build of another level.
+#define PACKER_DECLARE_KERNELS(isa)                                          \
+  namespace isa {                                                            \
+  void packRow(const uint8_t *row, size_t width,                             \
+               uint8_t *dst_b, uint8_t *dst_g, uint8_t *dst_r);              \
+  void packRow(const uint8_t *row, size_t width, float scale_factor,         \
+               float *dst_b, float *dst_g, float *dst_r);                    \
+  }
+
+namespace openvino_service {
+PACKER_DECLARE_KERNELS(packer_ANY)
+PACKER_DECLARE_KERNELS(packer_SSE42)
+PACKER_DECLARE_KERNELS(packer_AVX2)
+PACKER_DECLARE_KERNELS(packer_AVX512F)
+}
+
+#endif //OPENVINO_PIPELINE_LIB_BLOB_PACKER_KERNELS_H
@@ -1,33 +1,11 @@
 /**
- * @brief a header file with declaration of EmotionsDetection class and 
- * EmotionsResult class
+ * @brief a header file with declaration of EmotionsDetection class
  * @file emotions_recognition.cpp
  */
 #include "openvino_service/inferences/emotions_recognition.h"
 
 #include "openvino_service/slog.hpp"
 
-//EmotionsResult
-openvino_service::EmotionsResult::EmotionsResult(const cv::Rect &location) :
-Result(location){}
-
-void openvino_service::EmotionsResult::decorateFrame(
-    cv::Mat *frame, cv::Mat *camera_matrix) const {
-  std::ostringstream out;
-  cv::Rect rect = getLocation();
-
-  out.str("");
-  out << "Emotions: " <<
-      label_ << ": ";
-  cv::putText(*frame,
-              out.str(),
-              cv::Point2f(rect.x, rect.y - 30),
-              cv::FONT_HERSHEY_COMPLEX_SMALL,
-              0.8,
-              cv::Scalar(0, 255, 0));
-  cv::rectangle(*frame, rect, cv::Scalar(100, 100, 100), 1);
-}
-
 // Emotions Detection
 openvino_service::EmotionsDetection::EmotionsDetection()
     : openvino_service::BaseInference() {};
@@ -37,19 +15,22 @@ openvino_service::EmotionsDetection::~EmotionsDetection() = default;
 void openvino_service::EmotionsDetection::loadNetwork(
     const std::shared_ptr<Models::EmotionDetectionModel> network) {
   valid_model_ = network;
+  getResultTable() = ResultTable(ResultKind::EMOTIONS, 0,
+                                 &network->getLabels());
   setMaxBatchSize(network->getMaxBatchSize());
 }
 
 bool openvino_service::EmotionsDetection::enqueue(const cv::Mat &frame,
                                                   const cv::Rect &input_frame_loc) {
-  if (getEnqueuedNum() == 0) { results_.clear(); }
-  bool succeed = openvino_service::BaseInference::enqueue<float>(
-      frame, input_frame_loc, 1, getResultsLength(),
+  return openvino_service::BaseInference::enqueue<float>(
+      frame, input_frame_loc, 1, getEnqueuedNum(),
       valid_model_->getInputName());
-  if (!succeed ) return false;
-  Result r(input_frame_loc);
-  results_.emplace_back(r);
-  return true;
+}
+
+size_t openvino_service::EmotionsDetection::enqueueRegions(
+    const cv::Mat &frame, const std::vector<cv::Rect> &input_frame_locs) {
+  return openvino_service::BaseInference::enqueueRegions<float>(
+      frame, input_frame_locs, 1, valid_model_->getInputName());
 }
 
 bool openvino_service::EmotionsDetection::submitRequest() {
@@ -59,10 +40,15 @@ bool openvino_service::EmotionsDetection::submitRequest() {
 bool openvino_service::EmotionsDetection::fetchResults() {
   bool can_fetch = openvino_service::BaseInference::fetchResults();
   if (!can_fetch) return false;
+  ResultTable &results = getResultTable();
+  results.clear();
+  for (auto &location : getFinishedLocations()) {
+    results.addRow(location);
+  }
   int label_length = static_cast<int>(valid_model_->getLabels().size());
   std::string output_name = valid_model_->getOutputName();
   InferenceEngine::Blob::Ptr
-      emotions_blob = getEngine()->getRequest()->GetBlob(output_name);
+      emotions_blob = getFinishedRequest()->GetBlob(output_name);
   /** emotions vector must have the same size as number of channels
       in model output. Default output format is NCHW so we check index 1 */
   long num_of_channels = emotions_blob->getTensorDesc().getDims().at(1);
@@ -75,26 +61,17 @@ bool openvino_service::EmotionsDetection::fetchResults() {
   /** we identify an index of the most probable emotion in output array
       for idx image to return appropriate emotion name */
   auto emotions_values = emotions_blob->buffer().as<float *>();
-  for (int idx = 0; idx < results_.size(); ++idx) {
-    auto output_idx_pos = emotions_values + idx;
-    long max_prob_emotion_idx =
-        std::max_element(output_idx_pos, output_idx_pos + label_length) -
-            output_idx_pos;
-    results_[idx].label_ = valid_model_->getLabels()[max_prob_emotion_idx];
+  for (size_t idx = 0; idx < results.size(); ++idx) {
+    auto output_idx_pos = emotions_values + idx * label_length;
+    auto max_prob_emotion =
+        std::max_element(output_idx_pos, output_idx_pos + label_length);
+    results.setLabelId(idx, static_cast<int>(max_prob_emotion -
+                                             output_idx_pos));
+    results.setConfidence(idx, *max_prob_emotion);
   }
   return true;
 };
 
-
-const int openvino_service::EmotionsDetection::getResultsLength() const {
-  return (int)results_.size();
-};
-
-const openvino_service::Result*
-openvino_service::EmotionsDetection::getLocationResult(int idx) const {
-  return &(results_[idx]);
-};
-
 const std::string openvino_service::EmotionsDetection::getName() const {
   return valid_model_->getModelName();
 };
\ No newline at end of file
@@ -0,0 +1,58 @@
+/**
+ * @brief a header file with declaration of ResultTable class
+ * @file result_table.cpp
+ */
+#include "openvino_service/inferences/result_table.h"
+
+#include <stdexcept>
+
+openvino_service::ResultTable::ResultTable(
+    ResultKind kind, int attribute_count,
+    const std::vector<std::string> *labels)
+    : kind_(kind), attribute_count_(attribute_count), labels_(labels) {}
+
+void openvino_service::ResultTable::clear() {
+  locations_.clear();
+  confidences_.clear();
+  label_ids_.clear();
+  attributes_.clear();
+}
+
+size_t openvino_service::ResultTable::addRow(const cv::Rect &location) {
+  locations_.push_back(location);
+  confidences_.push_back(-1);
+  label_ids_.push_back(-1);
+  attributes_.resize(attributes_.size() + attribute_count_, -1);
+  return locations_.size() - 1;
+}
+
+void openvino_service::ResultTable::append(const ResultTable &other,
+                                           size_t begin, size_t end) {
+  if (empty()) {
+    kind_ = other.kind_;
+    attribute_count_ = other.attribute_count_;
+    labels_ = other.labels_;
+  } else if (kind_ != other.kind_) {
+    throw std::logic_error("Results of different kinds in one table");
+  }
+  locations_.insert(locations_.end(), other.locations_.begin() + begin,
+                    other.locations_.begin() + end);
+  confidences_.insert(confidences_.end(), other.confidences_.begin() + begin,
+                      other.confidences_.begin() + end);
+  label_ids_.insert(label_ids_.end(), other.label_ids_.begin() + begin,
+                    other.label_ids_.begin() + end);
+  attributes_.insert(attributes_.end(),
+                     other.attributes_.begin() + begin * attribute_count_,
+                     other.attributes_.begin() + end * attribute_count_);
+}
+
+std::string openvino_service::ResultTable::getLabel(size_t row) const {
+  int label_id = label_ids_[row];
+  if (label_id < 0) {
+    return "";
+  }
+  if (labels_ != nullptr && label_id < labels_->size()) {
+    return (*labels_)[label_id];
+  }
+  return "label #" + std::to_string(label_id);
+}
@@ -0,0 +1,50 @@
+/**
+ * @brief a header file with declaration of FramePool class
+ * @file frame_pool.cpp
+ */
+#include "openvino_service/inputs/frame_pool.h"
+
+namespace {
+/**
+ * @brief Whether nobody but the pool references the buffer.
+ */
+inline bool isFree(const cv::Mat &buffer) {
+  // other threads release their references concurrently
+  return buffer.u != nullptr && CV_XADD(&buffer.u->refcount, 0) == 1;
+}
+}
+
+//FramePool
+Input::FramePool::FramePool(size_t capacity) : capacity_(capacity) {}
+
+cv::Mat Input::FramePool::acquire(int rows, int cols, int type) {
+  if (rows <= 0 || cols <= 0) {
+    return cv::Mat();
+  }
+  for (auto &buffer : buffers_) {
+    if (buffer.rows == rows && buffer.cols == cols && buffer.type() == type
+        && isFree(buffer)) {
+      return buffer;
+    }
+  }
+  // free buffers of another size are dropped to make room
+  for (auto iter = buffers_.begin(); iter != buffers_.end();) {
+    if (isFree(*iter)) {
+      iter = buffers_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  if (buffers_.size() < capacity_) {
+    buffers_.emplace_back(rows, cols, type);
+    return buffers_.back();
+  }
+  return cv::Mat(rows, cols, type);
+}
+
+void Input::FramePool::setCapacity(size_t capacity) {
+  capacity_ = capacity;
+  if (buffers_.size() > capacity_) {
+    buffers_.resize(capacity_);
+  }
+}
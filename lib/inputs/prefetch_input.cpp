@@ -0,0 +1,146 @@
+/**
+ * @brief a header file with declaration of PrefetchInput class
+ * @file prefetch_input.cpp
+ */
+#include "openvino_service/inputs/prefetch_input.h"
+
+#include <algorithm>
+
+//PrefetchInput
+Input::PrefetchInput::PrefetchInput(std::unique_ptr<BaseInputDevice> device,
+                                    size_t capacity, OverflowPolicy policy)
+    : device_(std::move(device)), capacity_(std::max<size_t>(capacity, 1)),
+      frames_(capacity_), policy_(policy) {}
+
+Input::PrefetchInput::~PrefetchInput() {
+  stop_ = true;
+  wakeUp();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+bool Input::PrefetchInput::initialize() {
+  return start(device_->initialize());
+}
+
+bool Input::PrefetchInput::initialize(int t) {
+  return start(device_->initialize(t));
+}
+
+bool Input::PrefetchInput::initialize(size_t width, size_t height) {
+  return start(device_->initialize(width, height));
+}
+
+bool Input::PrefetchInput::start(bool device_init) {
+  setWidth(device_->getWidth());
+  setHeight(device_->getHeight());
+  setInitStatus(device_init);
+  if (device_init && !thread_.joinable()) {
+    thread_ = std::thread(&PrefetchInput::run, this);
+  }
+  return isInit();
+}
+
+void Input::PrefetchInput::run() {
+  while (!stop_) {
+    size_t pool_size = pool_size_.exchange(0);
+    if (pool_size > 0) {
+      device_->setFramePoolSize(pool_size);
+    }
+    cv::Mat frame;
+    if (!device_->read(&frame)) {
+      break;
+    }
+    while (!tryPush(frame)) {
+      if (policy_ == OverflowPolicy::DROP_NEWEST) {
+        ++dropped_frames_;
+        break;
+      }
+      if (policy_ == OverflowPolicy::DROP_OLDEST) {
+        cv::Mat oldest;
+        if (tryPop(&oldest)) {
+          ++dropped_frames_;
+        }
+        continue;
+      }
+      bool pushed = false;
+      waitUntil([&]() {
+        pushed = !stop_ && tryPush(frame);
+        return pushed || stop_;
+      });
+      if (pushed || stop_) {
+        break;
+      }
+    }
+    wakeUp();
+  }
+  finished_ = true;
+  wakeUp();
+}
+
+bool Input::PrefetchInput::read(cv::Mat *frame) {
+  if (!isInit()) { return false; }
+  bool popped = tryPop(frame);
+  if (!popped) {
+    waitUntil([&]() {
+      // frames buffered before the end of the input are still returned
+      bool finished = finished_;
+      popped = tryPop(frame);
+      return popped || finished;
+    });
+  }
+  if (popped) {
+    wakeUp();
+  }
+  return popped;
+}
+
+bool Input::PrefetchInput::tryPush(const cv::Mat &frame) {
+  // only the reading thread pushes, so the count cannot grow meanwhile
+  if (buffered_ >= capacity_ || !frames_.tryPush(frame)) {
+    return false;
+  }
+  ++buffered_;
+  return true;
+}
+
+bool Input::PrefetchInput::tryPop(cv::Mat *frame) {
+  if (!frames_.tryPop(frame)) {
+    return false;
+  }
+  --buffered_;
+  return true;
+}
+
+void Input::PrefetchInput::waitUntil(const std::function<bool()> &ready) {
+  ++waiting_;
+  // pairs with the fence in wakeUp(): either the waker sees this thread
+  // waiting, or this thread sees the change the waker made
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, ready);
+  }
+  --waiting_;
+}
+
+void Input::PrefetchInput::wakeUp() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiting_ == 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+  }
+  cv_.notify_all();
+}
+
+void Input::PrefetchInput::config() {
+  device_->config();
+}
+
+void Input::PrefetchInput::setFramePoolSize(size_t size) {
+  // the buffered frames and the one being read come from the same pool
+  pool_size_ = size + capacity_ + 1;
+}
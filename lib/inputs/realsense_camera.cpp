@@ -66,6 +66,8 @@ bool Input::RealSenseCamera::read(cv::Mat *frame) {
   } catch (...) {
     return false;
   }
+  // the only copy of the frame, from the librealsense buffer into the pool
+  *frame = acquireFrame();
   cv::Mat(cv::Size((int) getWidth(), (int) getHeight()),
           CV_8UC3,
           (void *) color_frame.get_data(),
@@ -33,6 +33,9 @@ bool Input::StandardCamera::initialize(size_t width, size_t height) {
 bool Input::StandardCamera::read(cv::Mat *frame) {
   if (!isInit()) { return false; }
   cap.grab();
+  // decode into a buffer of the pool, it is reused once the pipeline and the
+  // outputs are done with it
+  *frame = acquireFrame();
   return cap.retrieve(*frame);
 }
 
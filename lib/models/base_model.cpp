@@ -5,8 +5,6 @@
 
 #include "openvino_service/models/base_model.h"
 
-#include <fstream>
-
 #include "openvino_service/slog.hpp"
 
 //Validated Base Network
@@ -18,31 +16,17 @@ Models::BaseModel::BaseModel(
   if (model_loc.empty()) {
     throw std::logic_error("model file name is empty!");
   }
-  net_reader_ = std::make_shared<InferenceEngine::CNNNetReader>();
 }
 
 void Models::BaseModel::modelInit() {
-  slog::info << "Loading network files" << slog::endl;
-  //Read network model
-  net_reader_->ReadNetwork(model_loc_);
-  //Set batch size to given max_batch_size_
-  slog::info << "Batch size is set to  " << max_batch_size_ << slog::endl;
-  net_reader_->getNetwork().setBatchSize(max_batch_size_);
-  //Extract model name and load it's weights
-  //remove extension
-  size_t last_index = model_loc_.find_last_of(".");
-  std::string raw_name = model_loc_.substr(0, last_index);
-  std::string bin_file_name = raw_name + ".bin";
-  net_reader_->ReadWeights(bin_file_name);
-  //Read labels (if any)
-  std::string label_file_name = raw_name + ".labels";
-  std::ifstream input_file(label_file_name);
-  std::copy(std::istream_iterator<std::string>(input_file),
-            std::istream_iterator<std::string>(),
-            std::back_inserter(labels_));
-  checkNetworkSize(input_num_, output_num_, net_reader_);
-  checkLayerProperty(net_reader_);
-  setLayerProperty(net_reader_);
+  network_ = ModelRegistry::getInstance().getNetwork(
+      model_loc_, max_batch_size_, getModelName(), map_weights_);
+  // the labels are completed by checkLayerProperty, so each model has a copy
+  labels_ = network_->labels;
+  std::lock_guard<std::mutex> lock(network_->mutex);
+  checkNetworkSize(input_num_, output_num_, network_->net_reader);
+  checkLayerProperty(network_->net_reader);
+  setLayerProperty(network_->net_reader);
 }
 
 void Models::BaseModel::checkNetworkSize(
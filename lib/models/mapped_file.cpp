@@ -0,0 +1,41 @@
+/**
+ * @brief a header file with declaration of MappedFile class
+ * @file mapped_file.cpp
+ */
+#include "openvino_service/models/mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <stdexcept>
+
+Models::MappedFile::MappedFile(const std::string &file_name) {
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::logic_error("Cannot open " + file_name);
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+    close(fd);
+    throw std::logic_error("Cannot map empty file " + file_name);
+  }
+  size_ = static_cast<size_t>(file_stat.st_size);
+  // writable, so that a write gets a private copy of the page instead of a
+  // SIGSEGV
+  void *data =
+      mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  // the mapping stays valid after the file is closed
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw std::logic_error("Cannot map " + file_name);
+  }
+  // the weights are read soon after, start reading them in
+  madvise(data, size_, MADV_WILLNEED);
+  data_ = static_cast<uint8_t *>(data);
+}
+
+Models::MappedFile::~MappedFile() {
+  munmap(data_, size_);
+}
@@ -0,0 +1,169 @@
+/**
+ * @brief a header file with declaration of ModelRegistry class
+ * @file model_registry.cpp
+ */
+#include "openvino_service/models/model_registry.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <set>
+
+#include "openvino_service/slog.hpp"
+
+namespace {
+/**
+ * @brief Whether the plugin is known to copy the weights into memory of its
+ * own when a network is loaded: the CPU plugin into its primitives, the GPU
+ * plugin into device buffers. Other plugins may keep pointers to the weights
+ * blob.
+ */
+bool copiesWeights(InferenceEngine::InferencePlugin &plugin) {
+  static const std::set<std::string> copying_plugins = {"MKLDNNPlugin",
+                                                        "clDNNPlugin"};
+  const InferenceEngine::Version *version = plugin.GetVersion();
+  return version && version->description &&
+      copying_plugins.count(version->description);
+}
+}
+
+Models::ModelRegistry &Models::ModelRegistry::getInstance() {
+  static ModelRegistry registry;
+  return registry;
+}
+
+std::shared_ptr<Models::SharedNetwork> Models::ModelRegistry::getNetwork(
+    const std::string &model_loc, int batch_size,
+    const std::string &model_name, bool map_weights) {
+  std::shared_ptr<SharedNetwork> network;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    NetworkKey key(model_loc, batch_size, model_name);
+    network = networks_[key].lock();
+    if (!network) {
+      // forget the networks no model uses any more
+      for (auto iter = networks_.begin(); iter != networks_.end();) {
+        iter = iter->second.expired() ? networks_.erase(iter) :
+               std::next(iter);
+      }
+      network = std::make_shared<SharedNetwork>();
+      networks_[key] = network;
+    }
+  }
+  // the files are read outside of the registry lock, so that other networks
+  // can be read at the same time; if reading fails the next model retries
+  std::call_once(network->read_flag, [&]() {
+    readNetwork(model_loc, batch_size, map_weights, network.get());
+  });
+  return network;
+}
+
+void Models::ModelRegistry::readNetwork(const std::string &model_loc,
+                                        int batch_size, bool map_weights,
+                                        SharedNetwork *network) {
+  // a failed attempt may have left a reader over a mapping behind
+  network->net_reader.reset();
+  network->weights_file.reset();
+  network->weights_copied = false;
+  network->net_reader = std::make_shared<InferenceEngine::CNNNetReader>();
+  slog::info << "Loading network files" << slog::endl;
+  //Read network model
+  network->net_reader->ReadNetwork(model_loc);
+  //Set batch size to given batch_size
+  slog::info << "Batch size is set to  " << batch_size << slog::endl;
+  network->net_reader->getNetwork().setBatchSize(batch_size);
+  //Extract model name and load it's weights
+  //remove extension
+  size_t last_index = model_loc.find_last_of(".");
+  std::string raw_name = model_loc.substr(0, last_index);
+  std::string bin_file_name = raw_name + ".bin";
+  if (map_weights) {
+    try {
+      network->weights_file.reset(new MappedFile(bin_file_name));
+    } catch (const std::logic_error &error) {
+      slog::warn << error.what() << ", reading the weights instead"
+                 << slog::endl;
+    }
+  }
+  if (network->weights_file) {
+    // the blob points to the mapped pages; plugins not known to copy the
+    // weights get a copy in heap memory when the network is loaded
+    size_t size = network->weights_file->size();
+    auto weights = std::make_shared<InferenceEngine::TBlob<uint8_t>>(
+        InferenceEngine::TensorDesc(InferenceEngine::Precision::U8, {size},
+                                    InferenceEngine::Layout::C),
+        network->weights_file->data(), size);
+    network->net_reader->SetWeights(weights);
+  } else {
+    network->net_reader->ReadWeights(bin_file_name);
+  }
+  //Read labels (if any)
+  std::string label_file_name = raw_name + ".labels";
+  std::ifstream input_file(label_file_name);
+  network->labels.clear();
+  std::copy(std::istream_iterator<std::string>(input_file),
+            std::istream_iterator<std::string>(),
+            std::back_inserter(network->labels));
+}
+
+std::shared_ptr<Models::SharedExecutableNetwork>
+Models::ModelRegistry::getExecutableNetwork(
+    InferenceEngine::InferencePlugin plugin,
+    const std::shared_ptr<SharedNetwork> &network,
+    const std::map<std::string, std::string> &config) {
+  std::shared_ptr<SharedExecutableNetwork> executable_network;
+  std::mutex *plugin_mutex;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    InferenceEngine::InferenceEnginePluginPtr plugin_ptr(plugin);
+    std::unique_ptr<std::mutex> &load_mutex =
+        load_mutexes_[plugin_ptr.operator->()];
+    if (!load_mutex) {
+      load_mutex.reset(new std::mutex);
+    }
+    plugin_mutex = load_mutex.get();
+    ExecutableNetworkKey key(plugin_ptr.operator->(), network.get(), config);
+    executable_network = executable_networks_[key].lock();
+    if (!executable_network) {
+      // forget the executable networks no engine uses any more
+      for (auto iter = executable_networks_.begin();
+           iter != executable_networks_.end();) {
+        iter = iter->second.expired() ? executable_networks_.erase(iter) :
+               std::next(iter);
+      }
+      executable_network = std::make_shared<SharedExecutableNetwork>();
+      executable_network->network = network;
+      executable_network->plugin = plugin;
+      executable_networks_[key] = executable_network;
+    }
+  }
+  std::call_once(executable_network->load_flag, [&]() {
+    // the layer properties are not changed while the network is loaded
+    std::lock_guard<std::mutex> network_lock(network->mutex);
+    if (network->weights_file && !network->weights_copied &&
+        !copiesWeights(plugin)) {
+      copyWeights(network.get());
+    }
+    // the plugins are not known to be thread-safe, networks are loaded on
+    // each plugin one at a time
+    std::lock_guard<std::mutex> plugin_lock(*plugin_mutex);
+    executable_network->executable_network =
+        plugin.LoadNetwork(network->net_reader->getNetwork(), config);
+  });
+  return executable_network;
+}
+
+void Models::ModelRegistry::copyWeights(SharedNetwork *network) {
+  slog::info << "Copying the mapped weights for a plugin that may keep them"
+             << slog::endl;
+  size_t size = network->weights_file->size();
+  auto weights = std::make_shared<InferenceEngine::TBlob<uint8_t>>(
+      InferenceEngine::TensorDesc(InferenceEngine::Precision::U8, {size},
+                                  InferenceEngine::Layout::C));
+  weights->allocate();
+  std::copy(network->weights_file->data(),
+            network->weights_file->data() + size,
+            weights->buffer().as<uint8_t *>());
+  network->net_reader->SetWeights(weights);
+  network->weights_copied = true;
+}
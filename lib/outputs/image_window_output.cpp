@@ -11,8 +11,8 @@ Outputs::ImageWindowOutput::ImageWindowOutput(
 }
 
 void Outputs::ImageWindowOutput::feedFrame(const cv::Mat &frame) {
-  //frame_ = frame;
-  frame_ = frame.clone();
+  frame_ = frame;
+  frame_writable_ = false;
   if (camera_matrix_.empty()) {
     int cx = frame.cols / 2;
     int cy = frame.rows / 2;
@@ -25,17 +25,191 @@ void Outputs::ImageWindowOutput::feedFrame(const cv::Mat &frame) {
   }
 }
 
-void Outputs::ImageWindowOutput::accept(const openvino_service::Result& result) {
-  result.decorateFrame(&frame_, &camera_matrix_);
-};
+void Outputs::ImageWindowOutput::makeFrameWritable() {
+  if (!frame_writable_) {
+    frame_ = frame_.clone();
+    frame_writable_ = true;
+  }
+}
+
+void Outputs::ImageWindowOutput::accept(
+    const openvino_service::ResultTable &results) {
+  if (results.empty()) {
+    return;
+  }
+  makeFrameWritable();
+  switch (results.getKind()) {
+    case openvino_service::ResultKind::FACE_DETECTION:
+      decorateFaces(results);
+      break;
+    case openvino_service::ResultKind::EMOTIONS:
+      decorateEmotions(results);
+      break;
+    case openvino_service::ResultKind::AGE_GENDER:
+      decorateAgeGender(results);
+      break;
+    case openvino_service::ResultKind::HEAD_POSE:
+      decorateHeadPoses(results);
+      break;
+  }
+}
+
+void Outputs::ImageWindowOutput::decorateFaces(
+    const openvino_service::ResultTable &results) {
+  std::ostringstream out;
+  for (size_t i = 0; i < results.size(); ++i) {
+    const cv::Rect &rect = results.getLocation(i);
+    out.str("");
+    if (results.getConfidence(i) >= 0) {
+      out << "Face Detection Confidence: "
+          << std::fixed << std::setprecision(3)
+          << results.getConfidence(i);
+    }
+    cv::putText(frame_,
+                out.str(),
+                cv::Point2f(rect.x, rect.y - 15),
+                cv::FONT_HERSHEY_COMPLEX_SMALL,
+                0.8,
+                cv::Scalar(0, 0, 255));
+    cv::rectangle(frame_, rect, cv::Scalar(100, 100, 100), 1);
+  }
+}
+
+void Outputs::ImageWindowOutput::decorateEmotions(
+    const openvino_service::ResultTable &results) {
+  for (size_t i = 0; i < results.size(); ++i) {
+    const cv::Rect &rect = results.getLocation(i);
+    cv::putText(frame_,
+                "Emotions: " + results.getLabel(i) + ": ",
+                cv::Point2f(rect.x, rect.y - 30),
+                cv::FONT_HERSHEY_COMPLEX_SMALL,
+                0.8,
+                cv::Scalar(0, 255, 0));
+    cv::rectangle(frame_, rect, cv::Scalar(100, 100, 100), 1);
+  }
+}
+
+void Outputs::ImageWindowOutput::decorateAgeGender(
+    const openvino_service::ResultTable &results) {
+  using openvino_service::AgeGenderDetection;
+  std::ostringstream out;
+  for (size_t i = 0; i < results.size(); ++i) {
+    const cv::Rect &rect = results.getLocation(i);
+    out.str("");
+    out << "Age: " << results.getAttribute(i, AgeGenderDetection::AGE) << ","
+        << "Gender: "
+        << ((results.getAttribute(i, AgeGenderDetection::MALE_PROB) > 0.5) ?
+            "Male" : "Female");
+    cv::putText(frame_,
+                out.str(),
+                cv::Point2f(rect.x, rect.y-5),
+                cv::FONT_HERSHEY_COMPLEX_SMALL,
+                0.8,
+                cv::Scalar(0, 255, 0));
+    cv::rectangle(frame_, rect, cv::Scalar(100, 100, 100), 1);
+  }
+}
+
+void Outputs::ImageWindowOutput::decorateHeadPoses(
+    const openvino_service::ResultTable &results) {
+  using openvino_service::HeadPoseDetection;
+  int scale  = 50;
+  for (size_t i = 0; i < results.size(); ++i) {
+    double yaw = results.getAttribute(i, HeadPoseDetection::ANGLE_Y) *
+        CV_PI / 180.0;
+    double pitch = results.getAttribute(i, HeadPoseDetection::ANGLE_P) *
+        CV_PI / 180.0;
+    double roll = results.getAttribute(i, HeadPoseDetection::ANGLE_R) *
+        CV_PI / 180.0;
+    const cv::Rect &rect = results.getLocation(i);
+    cv::Point3f cpoint(rect.x + rect.width / 2, rect.y + rect.height / 2, 0);
+    cv::Matx33f Rx(1, 0, 0,
+                   0, cos(pitch), -sin(pitch),
+                   0, sin(pitch), cos(pitch));
+    cv::Matx33f Ry(cos(yaw), 0, -sin(yaw),
+                   0, 1, 0,
+                   sin(yaw), 0, cos(yaw));
+    cv::Matx33f Rz(cos(roll), -sin(roll), 0,
+                   sin(roll), cos(roll), 0,
+                   0, 0, 1);
+
+    auto r = cv::Mat(Rz * Ry * Rx);
+
+    cv::Mat xAxis(3, 1, CV_32F), yAxis(3, 1, CV_32F), zAxis(3, 1, CV_32F),
+        zAxis1(3, 1, CV_32F);
+
+    xAxis.at<float>(0) = 1 * scale;
+    xAxis.at<float>(1) = 0;
+    xAxis.at<float>(2) = 0;
+
+    yAxis.at<float>(0) = 0;
+    yAxis.at<float>(1) = -1 * scale;
+    yAxis.at<float>(2) = 0;
+
+    zAxis.at<float>(0) = 0;
+    zAxis.at<float>(1) = 0;
+    zAxis.at<float>(2) = -1 * scale;
+
+    zAxis1.at<float>(0) = 0;
+    zAxis1.at<float>(1) = 0;
+    zAxis1.at<float>(2) = 1 * scale;
+
+    cv::Mat o(3, 1, CV_32F, cv::Scalar(0));
+    o.at<float>(2) = camera_matrix_.at<float>(0);
+
+    xAxis = r * xAxis + o;
+    yAxis = r * yAxis + o;
+    zAxis = r * zAxis + o;
+    zAxis1 = r * zAxis1 + o;
+
+    cv::Point p1, p2;
+
+    p2.x = static_cast<int>(
+        (xAxis.at<float>(0) / xAxis.at<float>(2) * camera_matrix_.at<float>(0))
+            + cpoint.x);
+    p2.y = static_cast<int>(
+        (xAxis.at<float>(1) / xAxis.at<float>(2) * camera_matrix_.at<float>(4))
+            + cpoint.y);
+    cv::line(frame_, cv::Point(cpoint.x, cpoint.y), p2,
+             cv::Scalar(0, 0, 255), 2);
+
+    p2.x = static_cast<int>(
+        (yAxis.at<float>(0) / yAxis.at<float>(2) * camera_matrix_.at<float>(0))
+            + cpoint.x);
+    p2.y = static_cast<int>(
+        (yAxis.at<float>(1) / yAxis.at<float>(2) * camera_matrix_.at<float>(4))
+            + cpoint.y);
+    cv::line(frame_, cv::Point(cpoint.x, cpoint.y), p2,
+             cv::Scalar(0, 255, 0), 2);
+
+    p1.x = static_cast<int>(
+        (zAxis1.at<float>(0) / zAxis1.at<float>(2) *
+            camera_matrix_.at<float>(0)) + cpoint.x);
+    p1.y = static_cast<int>(
+        (zAxis1.at<float>(1) / zAxis1.at<float>(2) *
+            camera_matrix_.at<float>(4)) + cpoint.y);
+
+    p2.x = static_cast<int>(
+        (zAxis.at<float>(0) / zAxis.at<float>(2) * camera_matrix_.at<float>(0))
+            + cpoint.x);
+    p2.y = static_cast<int>(
+        (zAxis.at<float>(1) / zAxis.at<float>(2) * camera_matrix_.at<float>(4))
+            + cpoint.y);
+    cv::line(frame_, p1, p2, cv::Scalar(255, 0, 0), 2);
+    cv::circle(frame_, p2, 3, cv::Scalar(255, 0, 0), 2);
+  }
+}
 
 void Outputs::ImageWindowOutput::handleOutput(
     const std::string &overall_output_text) {
-  cv::putText(frame_,
-              overall_output_text,
-              cv::Point2f(0, 65),
-              cv::FONT_HERSHEY_TRIPLEX,
-              0.5,
-              cv::Scalar(255, 0, 0));
+  if (!overall_output_text.empty()) {
+    makeFrameWritable();
+    cv::putText(frame_,
+                overall_output_text,
+                cv::Point2f(0, 65),
+                cv::FONT_HERSHEY_TRIPLEX,
+                0.5,
+                cv::Scalar(255, 0, 0));
+  }
   cv::imshow(window_name_, frame_);
 }
\ No newline at end of file
@@ -6,20 +6,47 @@
 
 using namespace InferenceEngine;
 
-Pipeline::Pipeline() {
-  counter_ = 0;
+Pipeline::Pipeline()
+    : frame_latency_(profiler_.getHistogram("pipeline", "frame_latency_us")),
+      frames_in_flight_(profiler_.getGauge("pipeline", "frames_in_flight")),
+      workers_(new openvino_service::ThreadPool(1)) {}
+
+Pipeline::~Pipeline() {
+  // requests still running would call back into a destroyed pipeline; the
+  // pipeline is done once nothing can progress any more, even if a failure
+  // left some frames unfinished
+  std::unique_lock<std::mutex> lock(counter_mutex_);
+  while (true) {
+    bool finished = posted_tasks_ == 0;
+    for (int id : inference_nodes_) {
+      const auto &state = *nodes_[id].state;
+      if (state.active != 0 || !state.batch.empty()) finished = false;
+    }
+    if (finished) break;
+    progressBatches(&lock, true);
+  }
 }
 
 bool Pipeline::add(const std::string &name,
                    std::unique_ptr<Input::BaseInputDevice> input_device) {
-  input_device_name_ = name;
-  input_device_ = std::move(input_device);
+  compiled_ = false;
+  if (input_devices_.find(name) != input_devices_.end()) {
+    slog::err << "input device already exists!" << slog::endl;
+    return false;
+  }
+  // frames in flight, the frame held by the outputs and the one being read
+  input_device->setFramePoolSize(max_in_flight_frames_ + 2);
+  input_device_names_.push_back(name);
+  input_devices_[name] = std::move(input_device);
+  read_times_[name] = profiler_.getHistogram(name, "read_us");
+  dropped_frames_[name] = profiler_.getGauge(name, "dropped_frames");
   next_.insert({"", name});
   return true;
 };
 
 bool Pipeline::add(const std::string &parent, const std::string &name,
                    std::shared_ptr<Outputs::BaseOutput> output) {
+  compiled_ = false;
   if (parent.empty()) {
     slog::err << "output device have no parent!" << slog::endl;
     return false;
@@ -33,15 +60,26 @@ bool Pipeline::add(const std::string &parent, const std::string &name,
   }
   output_names_.insert(name);
   name_to_output_map_[name] = std::move(output);
+  output_times_[name] = profiler_.getHistogram(name, "output_us");
   next_.insert({parent, name});
   return true;
 };
 
 bool Pipeline::add(const std::string &parent, const std::string &name) {
+  compiled_ = false;
   if (parent.empty()) {
     slog::err << "output device should have no parent!" << slog::endl;
     return false;
   }
+  if (name_to_detection_map_.find(name) != name_to_detection_map_.end()) {
+    if (name_to_detection_map_.find(parent) == name_to_detection_map_.end()
+        && input_devices_.find(parent) == input_devices_.end()) {
+      slog::err << "parent device/detection does not exists!" << slog::endl;
+      return false;
+    }
+    next_.insert({parent, name});
+    return true;
+  }
   if (name_to_detection_map_.find(parent) == name_to_detection_map_.end()) {
     slog::err << "parent detection does not exists!" << slog::endl;
     return false;
@@ -57,49 +95,320 @@ bool Pipeline::add(const std::string &parent, const std::string &name) {
 
 bool Pipeline::add(const std::string &parent, const std::string &name,
                    std::shared_ptr<openvino_service::BaseInference> inference) {
+  compiled_ = false;
   if (name_to_detection_map_.find(parent) == name_to_detection_map_.end()
-      && input_device_name_ != parent) {
+      && input_devices_.find(parent) == input_devices_.end()) {
     slog::err << "parent device/detection does not exists!" << slog::endl;
     return false;
   }
+  // frames are only accepted once the engines are loaded
+  if (inference == nullptr || inference->getEngine() == nullptr) {
+    slog::err << "detection has no engine loaded!" << slog::endl;
+    return false;
+  }
+  auto iter = name_to_detection_map_.find(name);
+  if (iter != name_to_detection_map_.end()) {
+    if (iter->second != inference) {
+      slog::err << "detection already exists!" << slog::endl;
+      return false;
+    }
+    next_.insert({parent, name});
+    return true;
+  }
   next_.insert({parent, name});
   name_to_detection_map_[name] = std::move(inference);
+  auto &state = inference_states_[name];
+  state.enqueue_time = profiler_.getHistogram(name, "enqueue_us");
+  state.infer_time = profiler_.getHistogram(name, "infer_us");
+  state.fetch_time = profiler_.getHistogram(name, "fetch_us");
+  state.callback_time = profiler_.getHistogram(name, "callback_us");
+  state.batch_size_stats = profiler_.getHistogram(name, "batch_size");
+  state.queue_depth = profiler_.getGauge(name, "queue_depth");
   ++total_inference_;
   return true;
 };
 
+bool Pipeline::routeOutput(const std::string &output_name,
+                           const std::string &input_name) {
+  compiled_ = false;
+  if (output_names_.find(output_name) == output_names_.end()) {
+    slog::err << "output does not exists!" << slog::endl;
+    return false;
+  }
+  if (input_devices_.find(input_name) == input_devices_.end()) {
+    slog::err << "input device does not exists!" << slog::endl;
+    return false;
+  }
+  output_streams_[output_name].insert(input_name);
+  return true;
+}
+
+void Pipeline::setMaxInFlightFrames(size_t max_frames) {
+  max_in_flight_frames_ = std::max<size_t>(max_frames, 1);
+  for (auto &pair : input_devices_) {
+    pair.second->setFramePoolSize(max_in_flight_frames_ + 2);
+  }
+}
+
+bool Pipeline::compile() {
+  nodes_.clear();
+  input_nodes_.clear();
+  inference_nodes_.clear();
+  result_slot_num_ = 0;
+  std::map<std::string, int> ids;
+  auto add_node = [this, &ids](NodeKind kind, const std::string &name) {
+    ids[name] = static_cast<int>(nodes_.size());
+    nodes_.emplace_back();
+    nodes_.back().kind = kind;
+    nodes_.back().name = name;
+    return &nodes_.back();
+  };
+  for (auto &name : input_device_names_) {
+    input_nodes_.push_back(static_cast<int>(nodes_.size()));
+    Node *node = add_node(NodeKind::INPUT, name);
+    node->input = input_devices_.at(name).get();
+    node->time = read_times_.at(name);
+    node->dropped_frames = dropped_frames_.at(name);
+  }
+  for (auto &pair : name_to_detection_map_) {
+    inference_nodes_.push_back(static_cast<int>(nodes_.size()));
+    Node *node = add_node(NodeKind::INFERENCE, pair.first);
+    node->inference = pair.second.get();
+    node->state = &inference_states_.at(pair.first);
+    node->request_num = pair.second->getEngine()->getRequestNum();
+  }
+  for (auto &pair : name_to_output_map_) {
+    Node *node = add_node(NodeKind::OUTPUT, pair.first);
+    node->output = pair.second.get();
+    node->time = output_times_.at(pair.first);
+  }
+  // edges are walked in parent name order, so the outputs accept the
+  // results in inference name order
+  for (auto &edge : next_) {
+    if (edge.first.empty()) {
+      continue;
+    }
+    Node &parent = nodes_[ids.at(edge.first)];
+    int child_id = ids.at(edge.second);
+    Node &child = nodes_[child_id];
+    if (child.kind == NodeKind::INFERENCE) {
+      parent.next_inferences.push_back(child_id);
+    } else if (child.kind == NodeKind::OUTPUT) {
+      if (parent.result_slot < 0) {
+        parent.result_slot = static_cast<int>(result_slot_num_++);
+      }
+      child.result_slots.push_back(parent.result_slot);
+    }
+  }
+  for (int input_id : input_nodes_) {
+    for (auto &pair : name_to_output_map_) {
+      auto iter = output_streams_.find(pair.first);
+      if (iter == output_streams_.end() ||
+          iter->second.count(nodes_[input_id].name) != 0) {
+        nodes_[input_id].outputs.push_back(ids.at(pair.first));
+      }
+    }
+  }
+  // a cycle between the networks would feed a frame to them forever
+  enum { UNVISITED, VISITING, DONE };
+  std::vector<int> marks(nodes_.size(), UNVISITED);
+  std::function<bool(int)> visit = [&](int id) {
+    if (marks[id] == DONE) return true;
+    if (marks[id] == VISITING) {
+      slog::err << "pipeline has a cycle through " << nodes_[id].name
+                << "!" << slog::endl;
+      return false;
+    }
+    marks[id] = VISITING;
+    for (int next_id : nodes_[id].next_inferences) {
+      if (!visit(next_id)) return false;
+    }
+    marks[id] = DONE;
+    return true;
+  };
+  for (int id : inference_nodes_) {
+    if (!visit(id)) {
+      nodes_.clear();
+      return false;
+    }
+  }
+  compiled_ = true;
+  return true;
+}
+
 void Pipeline::runOnce() {
-  counter_ = 0;
-  if (!input_device_->read(&frame_)) {
-    throw std::logic_error("Failed to get frame from cv::VideoCapture");
-  }
-  width_ = frame_.cols;
-  height_ = frame_.rows;
-  for (auto &pair: name_to_output_map_) {
-    pair.second->feedFrame(frame_);
-  }
-  auto t0 = std::chrono::high_resolution_clock::now();
-  for (auto pos = next_.equal_range(input_device_name_);
-       pos.first != pos.second; ++pos.first) {
-    std::string detection_name = pos.first->second;
-    auto detection_ptr = name_to_detection_map_[detection_name];
-    detection_ptr->enqueue(
-        frame_, cv::Rect(width_ / 2, height_ / 2, width_, height_));
-    ++counter_;
-    detection_ptr->submitRequest();
+  if (!compiled_ && !compile()) {
+    throw std::logic_error("Invalid pipeline topology");
+  }
+  {
+    std::unique_lock<std::mutex> lock(counter_mutex_);
+    rethrowError(&lock);
+  }
+  for (int input_id : input_nodes_) {
+    const Node &input_node = nodes_[input_id];
+    std::shared_ptr<FrameContext> context;
+    {
+      std::lock_guard<std::mutex> lk(counter_mutex_);
+      if (!free_contexts_.empty()) {
+        context = std::move(free_contexts_.back());
+        free_contexts_.pop_back();
+      }
+    }
+    if (!context) {
+      context = std::make_shared<FrameContext>();
+    }
+    context->input_node = input_id;
+    context->results.resize(result_slot_num_);
+    context->read_time = std::chrono::steady_clock::now();
+    {
+      PROFILE_SCOPE(input_node.time);
+      if (!input_node.input->read(&context->frame)) {
+        throw std::logic_error("Failed to get frame from " + input_node.name);
+      }
+    }
+    PROFILE_SET(input_node.dropped_frames,
+                static_cast<int64_t>(input_node.input->getDroppedFrames()));
+    int width = context->frame.cols;
+    int height = context->frame.rows;
+    {
+      std::lock_guard<std::mutex> lk(counter_mutex_);
+      context->pending = static_cast<int>(input_node.next_inferences.size());
+      frames_.push_back(context);
+      PROFILE_SET(frames_in_flight_, static_cast<int64_t>(frames_.size()));
+    }
+    for (int inference_id : input_node.next_inferences) {
+      InferenceJob job;
+      job.context = context;
+      job.locations.emplace_back(width / 2, height / 2, width, height);
+      job.whole_frame = true;
+      schedule(inference_id, std::move(job));
+    }
+    waitForFrames(max_in_flight_frames_ - 1);
   }
+  dumpStatistics();
+}
+
+void Pipeline::flush() {
+  waitForFrames(0);
+}
+
+void Pipeline::setStatisticsDump(std::chrono::milliseconds interval,
+                                 std::ostream *stream, bool json) {
+  dump_interval_ = interval;
+  dump_stream_ = stream;
+  dump_json_ = json;
+  next_dump_ = std::chrono::steady_clock::now() + interval;
+}
+
+void Pipeline::dumpStatistics() {
+  if (dump_interval_.count() <= 0 || dump_stream_ == nullptr) {
+    return;
+  }
+  auto now = std::chrono::steady_clock::now();
+  if (now < next_dump_) {
+    return;
+  }
+  next_dump_ = now + dump_interval_;
+  *dump_stream_ << (dump_json_ ? profiler_.toJson() : profiler_.toText())
+                << std::endl;
+}
+
+void Pipeline::waitForFrames(size_t max_frames) {
   std::unique_lock<std::mutex> lock(counter_mutex_);
-  cv_.wait(lock, [self = this]() { return self->counter_ == 0; });
-  auto t1 = std::chrono::high_resolution_clock::now();
-  typedef std::chrono::duration<double, std::ratio<1, 1000>> ms;
-  //calculate fps
-  ms secondDetection = std::chrono::duration_cast<ms>(t1 - t0);
-  std::ostringstream out;
+  while (true) {
+    rethrowError(&lock);
+    // outputs are fed in reading order, so only finished frames at the front
+    // of the queue can be handled
+    while (!frames_.empty() && frames_.front()->pending == 0) {
+      auto context = frames_.front();
+      frames_.pop_front();
+      PROFILE_SET(frames_in_flight_, static_cast<int64_t>(frames_.size()));
+      lock.unlock();
+      handleOutputs(context.get());
+      PROFILE_RECORD(frame_latency_, static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - context->read_time).count()));
+      // the result tables keep their capacity for the next frames
+      context->frame.release();
+      for (auto &results : context->results) {
+        results.clear();
+      }
+      lock.lock();
+      if (context.use_count() == 1) {
+        free_contexts_.push_back(std::move(context));
+      }
+    }
+    if (frames_.size() <= max_frames) {
+      progressBatches(&lock, false);
+      break;
+    }
+    progressBatches(&lock, true);
+  }
+}
+
+std::vector<std::pair<int, Pipeline::InferenceBatch>>
+Pipeline::takeBatches(bool take_all) {
+  std::vector<std::pair<int, InferenceBatch>> ready;
+  auto now = std::chrono::steady_clock::now();
+  for (int id : inference_nodes_) {
+    auto &state = *nodes_[id].state;
+    if (state.batch.empty() || (!take_all && now < state.batch_deadline)) {
+      continue;
+    }
+    ready.emplace_back(id, std::move(state.batch));
+    state.batch.clear();
+    state.batch_size = 0;
+  }
+  return ready;
+}
+
+void Pipeline::progressBatches(std::unique_lock<std::mutex> *lock,
+                               bool wait) {
+  // while the caller waits and no request is running, nothing can join the
+  // collected batches any more, so they are started right away
+  bool idle = wait;
+  for (int id : inference_nodes_) {
+    if (nodes_[id].state->active != 0) idle = false;
+  }
+  auto ready = takeBatches(idle);
+  if (!ready.empty()) {
+    lock->unlock();
+    for (auto &pair : ready) {
+      dispatch(pair.first, std::move(pair.second));
+    }
+    lock->lock();
+    return;
+  }
+  if (!wait) {
+    return;
+  }
+  auto deadline = std::chrono::steady_clock::time_point::max();
+  for (int id : inference_nodes_) {
+    const auto &state = *nodes_[id].state;
+    if (!state.batch.empty()) {
+      deadline = std::min(deadline, state.batch_deadline);
+    }
+  }
+  if (deadline == std::chrono::steady_clock::time_point::max()) {
+    cv_.wait(*lock);
+  } else {
+    cv_.wait_until(*lock, deadline);
+  }
+}
+
+void Pipeline::handleOutputs(FrameContext *context) {
   std::string window_output_string = "";
-  //show fps?
-      //"(" + std::to_string(1000.f / secondDetection.count()) + " fps)";
-  for (auto &pair : name_to_output_map_) {
-    pair.second->handleOutput(window_output_string);
+  for (int output_id : nodes_[context->input_node].outputs) {
+    const Node &node = nodes_[output_id];
+    PROFILE_SCOPE(node.time);
+    node.output->feedFrame(context->frame);
+    for (int slot : node.result_slots) {
+      // inferences which got no input for this frame have no results
+      if (!context->results[slot].empty()) {
+        node.output->accept(context->results[slot]);
+      }
+    }
+    node.output->handleOutput(window_output_string);
   }
 }
 
@@ -112,62 +421,297 @@ void Pipeline::printPipeline() {
 }
 
 void Pipeline::setCallback() {
-  if (!input_device_->read(&frame_)) {
-    throw std::logic_error("Failed to get frame from cv::VideoCapture");
-  }
-  width_ = frame_.cols;
-  height_ = frame_.rows;
-  for (auto &pair: name_to_output_map_) {
-    pair.second->feedFrame(frame_);
-  }
-  for (auto &pair: name_to_detection_map_) {
-    std::string detection_name = pair.first;
-    std::function<void(void)> callb;
-    callb = [detection_name, self = this]() {
-      self->callback(detection_name);
-      return;
+  if (!compiled_ && !compile()) {
+    return;
+  }
+  for (int id : inference_nodes_) {
+    std::function<void(size_t)> callb;
+    callb = [id, self = this](size_t request_id) {
+      self->post([id, self, request_id]() {
+        self->finishRequest(id, request_id);
+      });
     };
-    pair.second->getEngine()->getRequest()->SetCompletionCallback(callb);
-  }
-}
-void Pipeline::callback(const std::string &detection_name) {
-  //slog::info<<"Hello callback"<<slog::endl;
-  auto detection_ptr = name_to_detection_map_[detection_name];
-  detection_ptr->fetchResults();
-  // set output
-  for (auto pos = next_.equal_range(detection_name);
-       pos.first != pos.second; ++pos.first) {
-    std::string next_name = pos.first->second;
-    // if next is output, then print
-    if (output_names_.find(next_name) != output_names_.end()) {
-      for (size_t i = 0; i < detection_ptr->getResultsLength(); ++i) {
-        name_to_output_map_[next_name]->accept(
-            *detection_ptr->getLocationResult(i));
+    nodes_[id].inference->getEngine()->setCompletionCallback(callb);
+  }
+}
+
+void Pipeline::setWorkerThreads(size_t thread_num,
+                                const std::vector<int> &cpus) {
+  workers_.reset();
+  if (thread_num > 0) {
+    workers_.reset(new openvino_service::ThreadPool(thread_num, cpus));
+  }
+}
+
+void Pipeline::post(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lk(counter_mutex_);
+    ++posted_tasks_;
+  }
+  auto guarded_task = [this, task]() {
+    try {
+      task();
+    } catch (...) {
+      setError(std::current_exception());
+    }
+    // notified under the lock, the pipeline may be destroyed right after
+    std::lock_guard<std::mutex> lk(counter_mutex_);
+    --posted_tasks_;
+    cv_.notify_all();
+  };
+  if (workers_) {
+    workers_->submit(std::move(guarded_task));
+  } else {
+    guarded_task();
+  }
+}
+
+void Pipeline::setError(std::exception_ptr error) {
+  {
+    std::lock_guard<std::mutex> lk(counter_mutex_);
+    if (!error_) {
+      error_ = error;
+    }
+  }
+  cv_.notify_all();
+}
+
+void Pipeline::rethrowError(std::unique_lock<std::mutex> *lock) {
+  if (!error_) {
+    return;
+  }
+  std::exception_ptr error = error_;
+  lock->unlock();
+  std::rethrow_exception(error);
+}
+
+void Pipeline::finishRequest(int node, size_t request_id) {
+  auto &state = *nodes_[node].state;
+  PROFILE_SCOPE(state.callback_time);
+  std::vector<BatchSegment> segments;
+  {
+    std::lock_guard<std::mutex> lk(counter_mutex_);
+    auto iter = state.running.find(request_id);
+    if (iter == state.running.end()) {
+      return;
+    }
+    segments = std::move(iter->second);
+    state.running.erase(iter);
+#ifdef ENABLE_PROFILING
+    auto submitted = state.submit_times.find(request_id);
+    if (submitted != state.submit_times.end()) {
+      PROFILE_RECORD(state.infer_time, static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - submitted->second).count()));
+      state.submit_times.erase(submitted);
+    }
+#endif
+  }
+  finishBatch(node, segments, static_cast<int>(request_id));
+}
+
+void Pipeline::schedule(int node, InferenceJob job) {
+  auto detection_ptr = nodes_[node].inference;
+  std::vector<InferenceBatch> ready;
+  bool new_deadline = false;
+  {
+    std::lock_guard<std::mutex> lk(counter_mutex_);
+    auto &state = *nodes_[node].state;
+    if (job.whole_frame || !detection_ptr->isBatchingEnabled()) {
+      ready.emplace_back();
+      ready.back().push_back(std::move(job));
+    } else {
+      // collect the jobs of consecutive frames until the batch is full
+      auto max_batch_size =
+          static_cast<size_t>(detection_ptr->getMaxBatchSize());
+      if (!state.batch.empty() &&
+          state.batch_size + job.locations.size() > max_batch_size) {
+        ready.push_back(std::move(state.batch));
+        state.batch.clear();
+        state.batch_size = 0;
+      }
+      if (state.batch.empty()) {
+        state.batch_deadline = std::chrono::steady_clock::now() +
+            detection_ptr->getBatchingDelay();
+        new_deadline = true;
       }
+      state.batch_size += job.locations.size();
+      state.batch.push_back(std::move(job));
+      if (state.batch_size >= max_batch_size) {
+        ready.push_back(std::move(state.batch));
+        state.batch.clear();
+        state.batch_size = 0;
+      }
+    }
+  }
+  // a thread waiting in progressBatches() must wake up by the new deadline
+  if (new_deadline) {
+    cv_.notify_all();
+  }
+  for (auto &batch : ready) {
+    dispatch(node, std::move(batch));
+  }
+}
+
+void Pipeline::dispatch(int node, InferenceBatch batch) {
+  {
+    std::lock_guard<std::mutex> lk(counter_mutex_);
+    auto &state = *nodes_[node].state;
+    if (state.active >= nodes_[node].request_num) {
+      state.queue.push_back(std::move(batch));
+      PROFILE_SET(state.queue_depth, static_cast<int64_t>(state.queue.size()));
+      return;
     }
-    // if next is network, set input for next network
-    else {
-      auto detection_ptr_iter = name_to_detection_map_.find(
-          next_name);
-      if (detection_ptr_iter != name_to_detection_map_.end()) {
-        auto next_detection_ptr = detection_ptr_iter->second;
-        for (size_t i = 0; i < detection_ptr->getResultsLength(); ++i) {
-          const openvino_service::Result *prev_result =
-              detection_ptr->getLocationResult(i);
-          auto clippedRect = prev_result->getLocation() & cv::Rect(0, 0,
-                                                             width_,
-                                                             height_);
-          cv::Mat next_input = frame_(clippedRect);
-          next_detection_ptr->enqueue(next_input, prev_result->getLocation());
+    ++state.active;
+  }
+  startBatch(node, batch);
+}
+
+void Pipeline::startBatch(int node, const InferenceBatch &batch) {
+  auto detection_ptr = nodes_[node].inference;
+  auto &state = *nodes_[node].state;
+  std::vector<BatchSegment> segments;
+  {
+    std::lock_guard<std::mutex> inference_lock(state.mutex);
+    PROFILE_SCOPE(state.enqueue_time);
+    int request_id = -1;
+    try {
+      for (auto &job : batch) {
+        const cv::Mat &frame = job.context->frame;
+        BatchSegment segment;
+        segment.context = job.context;
+        if (job.whole_frame) {
+          segment.count += detection_ptr->enqueue(frame,
+                                                  job.locations.front());
+        } else {
+          segment.count += detection_ptr->enqueueRegions(frame,
+                                                         job.locations);
+        }
+        segments.push_back(std::move(segment));
+      }
+      request_id = detection_ptr->getEnqueuedRequest();
+      if (request_id >= 0) {
+        PROFILE_RECORD(state.batch_size_stats,
+                       static_cast<uint64_t>(detection_ptr->getEnqueuedNum()));
+        {
+          std::lock_guard<std::mutex> lk(counter_mutex_);
+          state.running[request_id] = segments;
+#ifdef ENABLE_PROFILING
+          state.submit_times[request_id] = std::chrono::steady_clock::now();
+#endif
         }
-        if (detection_ptr->getResultsLength() > 0) {
-          ++counter_;
-          next_detection_ptr->submitRequest();
+        if (detection_ptr->submitRequest()) {
+          return;
         }
+        throw std::runtime_error("Failed to start a request of " +
+                                 nodes_[node].name);
       }
+    } catch (...) {
+      // the frames of the batch finish without results of this inference
+      detection_ptr->discardEnqueuedRequest();
+      segments.clear();
+      for (auto &job : batch) {
+        BatchSegment segment;
+        segment.context = job.context;
+        segments.push_back(std::move(segment));
+      }
+      setError(std::current_exception());
+    }
+    // the request did not start, submitRequest() or discardEnqueuedRequest()
+    // gave it back to the engine
+    if (request_id >= 0) {
+      std::lock_guard<std::mutex> lk(counter_mutex_);
+      state.running.erase(request_id);
+#ifdef ENABLE_PROFILING
+      state.submit_times.erase(request_id);
+#endif
     }
   }
-  std::lock_guard<std::mutex> lk(counter_mutex_);
-  --counter_;
+  finishBatch(node, segments, -1);
+}
+
+void Pipeline::finishBatch(int node,
+                           const std::vector<BatchSegment> &segments,
+                           int request_id) {
+  auto detection_ptr = nodes_[node].inference;
+  auto &state = *nodes_[node].state;
+  const std::vector<int> &next_inferences = nodes_[node].next_inferences;
+  const int result_slot = nodes_[node].result_slot;
+  // jobs for the next networks, for each segment of the request
+  std::vector<std::vector<std::pair<int, InferenceJob>>>
+      next_jobs(segments.size());
+  if (request_id >= 0) {
+    std::lock_guard<std::mutex> inference_lock(state.mutex);
+    PROFILE_SCOPE(state.fetch_time);
+    detection_ptr->setFinishedRequest(static_cast<size_t>(request_id));
+    try {
+      detection_ptr->fetchResults();
+      const openvino_service::ResultTable &results =
+          detection_ptr->getResults();
+      // a request of several segments holds one result per input, in enqueue
+      // order; a single segment owns all results (e.g. detections of a frame)
+      size_t begin = 0;
+      for (size_t k = 0; k < segments.size(); ++k) {
+        size_t end = segments.size() == 1 ? results.size() :
+                     std::min(results.size(), begin + segments[k].count);
+        // if next is output, keep the results until the frame is finished
+        if (result_slot >= 0) {
+          std::lock_guard<std::mutex> lk(counter_mutex_);
+          segments[k].context->results[result_slot].append(results, begin,
+                                                           end);
+        }
+        // if next is network, set input for next network
+        for (size_t n = 0; n < next_inferences.size() && begin < end; ++n) {
+          InferenceJob job;
+          job.context = segments[k].context;
+          job.locations.assign(results.getLocations().begin() + begin,
+                               results.getLocations().begin() + end);
+          next_jobs[k].emplace_back(next_inferences[n], std::move(job));
+        }
+        begin = end;
+      }
+    } catch (...) {
+      // the frames of the request finish without its results
+      for (auto &jobs : next_jobs) {
+        jobs.clear();
+      }
+      setError(std::current_exception());
+    }
+    detection_ptr->releaseFinishedRequest();
+  }
+  // a request is free again, start the next batch (if any)
+  InferenceBatch next_batch;
+  bool has_next_batch = false;
+  std::vector<std::pair<int, InferenceBatch>> due_batches;
+  {
+    std::lock_guard<std::mutex> lk(counter_mutex_);
+    for (size_t k = 0; k < segments.size(); ++k) {
+      segments[k].context->pending +=
+          static_cast<int>(next_jobs[k].size()) - 1;
+    }
+    if (state.queue.empty()) {
+      --state.active;
+    } else {
+      next_batch = std::move(state.queue.front());
+      state.queue.pop_front();
+      PROFILE_SET(state.queue_depth, static_cast<int64_t>(state.queue.size()));
+      has_next_batch = true;
+    }
+    due_batches = takeBatches(false);
+  }
   cv_.notify_all();
+  // each next network crops and packs its inputs in its own task
+  for (auto &jobs : next_jobs) {
+    for (auto &pair : jobs) {
+      int next_id = pair.first;
+      InferenceJob job = std::move(pair.second);
+      post([this, next_id, job]() { schedule(next_id, job); });
+    }
+  }
+  for (auto &pair : due_batches) {
+    dispatch(pair.first, std::move(pair.second));
+  }
+  if (has_next_batch) {
+    startBatch(node, next_batch);
+  }
 }
@@ -0,0 +1,242 @@
+/**
+ * @brief a header file with declaration of Profiler class
+ * @file profiler.cpp
+ */
+#include "openvino_service/profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+/**
+ * @brief Write a string as a JSON string literal, with its quotes.
+ */
+void writeJsonString(std::ostream &out, const std::string &value) {
+  out << '"';
+  for (char c : value) {
+    switch (c) {
+      case '"': out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\b': out << "\\b"; break;
+      case '\f': out << "\\f"; break;
+      case '\n': out << "\\n"; break;
+      case '\r': out << "\\r"; break;
+      case '\t': out << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+              << static_cast<int>(c) << std::dec << std::setfill(' ');
+        } else {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+}
+}
+
+//Histogram
+openvino_service::Histogram::Histogram() {
+  reset();
+}
+
+size_t openvino_service::Histogram::bucketOf(uint64_t value) {
+  if (value < 8) {
+    return static_cast<size_t>(value);
+  }
+  // exponent e >= 3, then the two bits below the leading one
+  size_t exponent = 63 - static_cast<size_t>(__builtin_clzll(value));
+  size_t sub_bucket = static_cast<size_t>(value >> (exponent - 2)) & 3;
+  return 8 + (exponent - 3) * 4 + sub_bucket;
+}
+
+uint64_t openvino_service::Histogram::bucketUpperBound(size_t bucket) {
+  if (bucket < 8) {
+    return bucket;
+  }
+  size_t exponent = (bucket - 8) / 4 + 3;
+  uint64_t sub_bucket = (bucket - 8) % 4;
+  return ((5 + sub_bucket) << (exponent - 2)) - 1;
+}
+
+void openvino_service::Histogram::record(uint64_t value) {
+  buckets_[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+  uint64_t max = max_.load(std::memory_order_relaxed);
+  while (value > max &&
+         !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+  }
+}
+
+double openvino_service::Histogram::getMean() const {
+  uint64_t count = getCount();
+  return count == 0 ? 0 : static_cast<double>(sum_.load()) / count;
+}
+
+uint64_t openvino_service::Histogram::getPercentile(double quantile) const {
+  uint64_t count = getCount();
+  if (count == 0) {
+    return 0;
+  }
+  auto rank = static_cast<uint64_t>(std::ceil(quantile * count));
+  rank = std::max<uint64_t>(rank, 1);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBuckets; ++i) {
+    seen += buckets_[i].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      return std::min(bucketUpperBound(i), getMax());
+    }
+  }
+  return getMax();
+}
+
+void openvino_service::Histogram::reset() {
+  for (auto &bucket : buckets_) {
+    bucket.store(0);
+  }
+  count_ = 0;
+  sum_ = 0;
+  max_ = 0;
+}
+
+//Gauge
+void openvino_service::Gauge::set(int64_t value) {
+  value_.store(value, std::memory_order_relaxed);
+  raiseMax(value);
+}
+
+void openvino_service::Gauge::add(int64_t delta) {
+  raiseMax(value_.fetch_add(delta, std::memory_order_relaxed) + delta);
+}
+
+void openvino_service::Gauge::raiseMax(int64_t value) {
+  int64_t max = max_.load(std::memory_order_relaxed);
+  while (value > max &&
+         !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+  }
+}
+
+void openvino_service::Gauge::reset() {
+  max_ = value_.load();
+}
+
+//Profiler
+openvino_service::Profiler::Profiler()
+    : start_(std::chrono::steady_clock::now()) {}
+
+openvino_service::Histogram *openvino_service::Profiler::getHistogram(
+    const std::string &node, const std::string &metric) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &histogram = histograms_[{node, metric}];
+  if (histogram == nullptr) {
+    histogram.reset(new Histogram());
+  }
+  return histogram.get();
+}
+
+openvino_service::Gauge *openvino_service::Profiler::getGauge(
+    const std::string &node, const std::string &metric) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &gauge = gauges_[{node, metric}];
+  if (gauge == nullptr) {
+    gauge.reset(new Gauge());
+  }
+  return gauge.get();
+}
+
+std::vector<openvino_service::Profiler::HistogramStats>
+openvino_service::Profiler::getHistogramStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<HistogramStats> stats;
+  for (auto &pair : histograms_) {
+    const Histogram &histogram = *pair.second;
+    stats.push_back({pair.first.first, pair.first.second,
+                     histogram.getCount(), histogram.getMean(),
+                     histogram.getPercentile(0.5),
+                     histogram.getPercentile(0.95),
+                     histogram.getPercentile(0.99), histogram.getMax()});
+  }
+  return stats;
+}
+
+std::vector<openvino_service::Profiler::GaugeStats>
+openvino_service::Profiler::getGaugeStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<GaugeStats> stats;
+  for (auto &pair : gauges_) {
+    stats.push_back({pair.first.first, pair.first.second,
+                     pair.second->getValue(), pair.second->getMax()});
+  }
+  return stats;
+}
+
+double openvino_service::Profiler::getElapsedSeconds() const {
+  return std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start_).count();
+}
+
+std::string openvino_service::Profiler::toText() const {
+  std::ostringstream out;
+  out << "Statistics over " << std::fixed << std::setprecision(1)
+      << getElapsedSeconds() << " s" << std::endl;
+  out << std::left << std::setw(24) << "node" << std::setw(20) << "metric"
+      << std::right << std::setw(10) << "count" << std::setw(12) << "mean"
+      << std::setw(10) << "p50" << std::setw(10) << "p95"
+      << std::setw(10) << "p99" << std::setw(10) << "max" << std::endl;
+  for (auto &stats : getHistogramStats()) {
+    out << std::left << std::setw(24) << stats.node << std::setw(20)
+        << stats.metric << std::right << std::setw(10) << stats.count
+        << std::setw(12) << stats.mean << std::setw(10) << stats.p50
+        << std::setw(10) << stats.p95 << std::setw(10) << stats.p99
+        << std::setw(10) << stats.max << std::endl;
+  }
+  for (auto &stats : getGaugeStats()) {
+    out << std::left << std::setw(24) << stats.node << std::setw(20)
+        << stats.metric << std::right << std::setw(10) << stats.value
+        << " (max " << stats.max << ")" << std::endl;
+  }
+  return out.str();
+}
+
+std::string openvino_service::Profiler::toJson() const {
+  std::ostringstream out;
+  out << "{\"elapsed_s\": " << getElapsedSeconds() << ", \"histograms\": [";
+  bool first = true;
+  for (auto &stats : getHistogramStats()) {
+    out << (first ? "" : ", ") << "{\"node\": ";
+    writeJsonString(out, stats.node);
+    out << ", \"metric\": ";
+    writeJsonString(out, stats.metric);
+    out << ", \"count\": " << stats.count << ", \"mean\": " << stats.mean
+        << ", \"p50\": " << stats.p50 << ", \"p95\": " << stats.p95
+        << ", \"p99\": " << stats.p99 << ", \"max\": " << stats.max << "}";
+    first = false;
+  }
+  out << "], \"gauges\": [";
+  first = true;
+  for (auto &stats : getGaugeStats()) {
+    out << (first ? "" : ", ") << "{\"node\": ";
+    writeJsonString(out, stats.node);
+    out << ", \"metric\": ";
+    writeJsonString(out, stats.metric);
+    out << ", \"value\": " << stats.value << ", \"max\": " << stats.max
+        << "}";
+    first = false;
+  }
+  out << "]}";
+  return out.str();
+}
+
+void openvino_service::Profiler::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &pair : histograms_) {
+    pair.second->reset();
+  }
+  for (auto &pair : gauges_) {
+    pair.second->reset();
+  }
+  start_ = std::chrono::steady_clock::now();
+}
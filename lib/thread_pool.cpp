@@ -0,0 +1,119 @@
+/**
+ * @brief a header file with declaration of ThreadPool class
+ * @file thread_pool.cpp
+ */
+#include "openvino_service/thread_pool.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <exception>
+
+#include "openvino_service/slog.hpp"
+
+namespace {
+// pool and queue of the worker running on the current thread
+thread_local const openvino_service::ThreadPool *current_pool = nullptr;
+thread_local size_t current_queue = 0;
+}
+
+openvino_service::ThreadPool::ThreadPool(size_t thread_num,
+                                         const std::vector<int> &cpus) {
+  thread_num = std::max<size_t>(thread_num, 1);
+  for (size_t i = 0; i < thread_num; ++i) {
+    queues_.emplace_back(new WorkerQueue);
+  }
+  for (size_t i = 0; i < thread_num; ++i) {
+    threads_.emplace_back(&ThreadPool::run, this, i);
+#if defined(__linux__)
+    if (!cpus.empty()) {
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      CPU_SET(cpus[i % cpus.size()], &cpu_set);
+      if (pthread_setaffinity_np(threads_.back().native_handle(),
+                                 sizeof(cpu_set), &cpu_set) != 0) {
+        slog::warn << "Cannot pin worker " << i << " to CPU "
+                   << cpus[i % cpus.size()] << slog::endl;
+      }
+    }
+#endif
+  }
+}
+
+openvino_service::ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+void openvino_service::ThreadPool::submit(std::function<void()> task) {
+  size_t index = current_pool == this ? current_queue :
+                 next_queue_.fetch_add(1) % queues_.size();
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++queued_;
+  }
+  cv_.notify_one();
+}
+
+bool openvino_service::ThreadPool::popTask(size_t index,
+                                           std::function<void()> *task) {
+  // oldest task of the own queue first, so that the tasks of older frames
+  // are not overtaken by the ones of newer frames
+  {
+    auto &queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      *task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      --queued_;
+      return true;
+    }
+  }
+  // then steal the oldest task of another queue
+  for (size_t i = 1; i < queues_.size(); ++i) {
+    auto &queue = *queues_[(index + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      *task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      --queued_;
+      return true;
+    }
+  }
+  return false;
+}
+
+void openvino_service::ThreadPool::run(size_t index) {
+  current_pool = this;
+  current_queue = index;
+  while (true) {
+    std::function<void()> task;
+    if (popTask(index, &task)) {
+      try {
+        task();
+      } catch (const std::exception &error) {
+        slog::err << error.what() << slog::endl;
+      } catch (...) {
+        slog::err << "Unknown exception in a worker thread" << slog::endl;
+      }
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return queued_ > 0 || stopping_; });
+    if (stopping_ && queued_ == 0) {
+      return;
+    }
+  }
+}
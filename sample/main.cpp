@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <iterator>
 #include <map>
+#include <sstream>
 
 #include "mkldnn/mkldnn_extension_ptr.hpp"
 #include "inference_engine.hpp"
@@ -28,6 +29,8 @@
 #include "openvino_service/inferences/head_pose_recognition.h"
 #include "openvino_service/inferences/face_detection.h"
 #include "openvino_service/engines/engine.h"
+#include "openvino_service/engines/engine_loader.h"
+#include "openvino_service/inputs/prefetch_input.h"
 #include "openvino_service/outputs/image_window_output.h"
 #include "openvino_service/common.hpp"
 #include "openvino_service/slog.hpp"
@@ -58,6 +61,17 @@ bool parseAndCheckCommandLine(int argc, char **argv) {
   if (FLAGS_n_hp < 1) {
     throw std::logic_error("Parameter -n_hp cannot be 0");
   }
+  if (FLAGS_n_fr < 1) {
+    throw std::logic_error("Parameter -n_fr cannot be 0");
+  }
+  if (FLAGS_n_req < 1) {
+    throw std::logic_error("Parameter -n_req cannot be 0");
+  }
+  if (FLAGS_overflow != "block" && FLAGS_overflow != "drop_oldest" &&
+      FLAGS_overflow != "drop_newest") {
+    throw std::logic_error("Parameter -overflow must be block, drop_oldest "
+                           "or drop_newest");
+  }
   return true;
 }
 
@@ -92,85 +106,156 @@ int main(int argc, char *argv[]) {
           device_name, FLAGS_l, FLAGS_c, FLAGS_pc);
     }
 
-    // --------------------------- 2. Generate Input Device and Output Device--------------------------------
+    // --------------------------- 2. Load Networks --------------------------------------------------------
+    // all networks are read, loaded and warmed up in the background while
+    // the input devices are opened
+    auto face_detection_model =
+        std::make_shared<Models::FaceDetectionModel>(
+            FLAGS_m, 1, 1, 1);
+    auto emotions_detection_model =
+        std::make_shared<Models::EmotionDetectionModel>(
+            FLAGS_m_em, 1, 1, 16);
+    auto agegender_detection_model =
+        std::make_shared<Models::AgeGenderDetectionModel>(
+            FLAGS_m_ag, 1, 2, 16);
+    auto headpose_detection_network =
+        std::make_shared<Models::HeadPoseDetectionModel>(
+            FLAGS_m_hp, 1, 3, 16);
+    Engines::EngineLoader engine_loader;
+    size_t face_detection_engine_id = engine_loader.add(
+        face_detection_model, plugins_for_devices[FLAGS_d], FLAGS_n_req);
+    size_t emotions_detection_engine_id = engine_loader.add(
+        emotions_detection_model, plugins_for_devices[FLAGS_d_em],
+        FLAGS_n_req);
+    size_t agegender_detection_engine_id = engine_loader.add(
+        agegender_detection_model, plugins_for_devices[FLAGS_d_ag],
+        FLAGS_n_req);
+    size_t headpose_detection_engine_id = engine_loader.add(
+        headpose_detection_network, plugins_for_devices[FLAGS_d_hp],
+        FLAGS_n_req);
+    engine_loader.start(FLAGS_warm_up);
+
+    // --------------------------- 3. Generate Input Device and Output Device--------------------------------
     slog::info << "Reading input" << slog::endl;
-    auto input_ptr = Factory::makeInputDeviceByName(FLAGS_i);
-    if (!input_ptr->initialize()) {
-      throw std::logic_error("Cannot open input file or camera: " + FLAGS_i);
+    // one input device and one window for each comma separated input
+    std::vector<std::string> inputs;
+    std::istringstream input_list(FLAGS_i);
+    for (std::string input; std::getline(input_list, input, ',');) {
+      inputs.push_back(input);
+    }
+    std::vector<std::unique_ptr<Input::BaseInputDevice>> input_ptrs;
+    std::vector<std::string> window_names;
+    std::vector<std::shared_ptr<Outputs::ImageWindowOutput>> output_ptrs;
+    auto overflow_policy = Input::PrefetchInput::OverflowPolicy::BLOCK;
+    if (FLAGS_overflow == "drop_oldest") {
+      overflow_policy = Input::PrefetchInput::OverflowPolicy::DROP_OLDEST;
+    } else if (FLAGS_overflow == "drop_newest") {
+      overflow_policy = Input::PrefetchInput::OverflowPolicy::DROP_NEWEST;
+    }
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      auto input_ptr = Factory::makeInputDeviceByName(inputs[i]);
+      if (FLAGS_prefetch > 0) {
+        input_ptr = std::make_unique<Input::PrefetchInput>(
+            std::move(input_ptr), FLAGS_prefetch, overflow_policy);
+      }
+      if (!input_ptr->initialize()) {
+        throw std::logic_error("Cannot open input file or camera: " +
+            inputs[i]);
+      }
+      input_ptrs.push_back(std::move(input_ptr));
+      std::string suffix = i == 0 ? "" : " " + std::to_string(i);
+      window_names.push_back("Results" + suffix);
+      output_ptrs.push_back(
+          std::make_shared<Outputs::ImageWindowOutput>(window_names.back()));
     }
-    std::string window_name = "Results";
-    auto output_ptr =
-        std::make_shared<Outputs::ImageWindowOutput>(window_name);
 
-    // --------------------------- 3. Generate Inference Instance-------------------------------------------
+    // --------------------------- 4. Generate Inference Instance-------------------------------------------
+    engine_loader.wait();
+    for (auto &timings : engine_loader.getTimings()) {
+      slog::info << timings.name << ": load " << timings.load_ms
+                 << " ms, compile " << timings.compile_ms << " ms, warm-up "
+                 << timings.warm_up_ms << " ms" << slog::endl;
+    }
     //generate face detection inference
-    auto face_detection_model =
-        std::make_shared<Models::FaceDetectionModel>(
-            FLAGS_m, 1, 1, 1);
-    face_detection_model->modelInit();
-    auto face_detection_engine =
-        std::make_shared<Engines::Engine>(
-            plugins_for_devices[FLAGS_d],face_detection_model);
     auto face_inference_ptr =
         std::make_shared<openvino_service::FaceDetection >(FLAGS_t);
     face_inference_ptr->loadNetwork(face_detection_model);
-    face_inference_ptr->loadEngine(face_detection_engine);
+    face_inference_ptr->loadEngine(
+        engine_loader.getEngine(face_detection_engine_id));
 
     //generate emotions detection inference
-    auto emotions_detection_model =
-        std::make_shared<Models::EmotionDetectionModel>(
-            FLAGS_m_em, 1, 1, 16);
-    emotions_detection_model->modelInit();
-    auto emotions_detection_engine =
-        std::make_shared<Engines::Engine>(
-            plugins_for_devices[FLAGS_d_em],emotions_detection_model);
     auto emotions_inference_ptr =
         std::make_shared<openvino_service::EmotionsDetection>();
     emotions_inference_ptr->loadNetwork(emotions_detection_model);
-    emotions_inference_ptr->loadEngine(emotions_detection_engine);
+    emotions_inference_ptr->loadEngine(
+        engine_loader.getEngine(emotions_detection_engine_id));
 
     //generate age gender detection inference
-    auto agegender_detection_model =
-        std::make_shared<Models::AgeGenderDetectionModel>(
-            FLAGS_m_ag, 1, 2, 16);
-    agegender_detection_model->modelInit();
-    auto agegender_detection_engine =
-        std::make_shared<Engines::Engine>(
-            plugins_for_devices[FLAGS_d_ag],agegender_detection_model);
     auto agegender_inference_ptr =
         std::make_shared<openvino_service::AgeGenderDetection>();
     agegender_inference_ptr->loadNetwork(agegender_detection_model);
-    agegender_inference_ptr->loadEngine(agegender_detection_engine);
+    agegender_inference_ptr->loadEngine(
+        engine_loader.getEngine(agegender_detection_engine_id));
 
     //generate head pose estimation inference
-    auto headpose_detection_network =
-        std::make_shared<Models::HeadPoseDetectionModel>(
-            FLAGS_m_hp, 1, 3, 16);
-    headpose_detection_network->modelInit();
-    auto headpose_detection_engine =
-        std::make_shared<Engines::Engine>(
-            plugins_for_devices[FLAGS_d_hp],headpose_detection_network);
     auto headpose_inference_ptr =
         std::make_shared<openvino_service::HeadPoseDetection>();
     headpose_inference_ptr->loadNetwork(headpose_detection_network);
-    headpose_inference_ptr->loadEngine(headpose_detection_engine);
+    headpose_inference_ptr->loadEngine(
+        engine_loader.getEngine(headpose_detection_engine_id));
 
-    // --------------------------- 4. Build Pipeline -------------------------------------------------------
+    if (FLAGS_batch_ms > 0) {
+      auto delay = std::chrono::milliseconds(FLAGS_batch_ms);
+      emotions_inference_ptr->setBatchingPolicy(true, delay);
+      agegender_inference_ptr->setBatchingPolicy(true, delay);
+      headpose_inference_ptr->setBatchingPolicy(true, delay);
+    }
+
+    // --------------------------- 5. Build Pipeline -------------------------------------------------------
     Pipeline pipe;
-    pipe.add("video_input", std::move(input_ptr));
-    pipe.add("video_input", "face_detection", face_inference_ptr);
-    pipe.add("face_detection", "emotions_detection", emotions_inference_ptr);
-    pipe.add("face_detection", "age_gender_detection", agegender_inference_ptr);
-    pipe.add("face_detection", "headpose_detection", headpose_inference_ptr);
-    pipe.add("emotions_detection", "video_output", output_ptr);
-    pipe.add("age_gender_detection", "video_output", output_ptr);
-    pipe.add("headpose_detection", "video_output", output_ptr);
+    // all inputs share the same networks, each one has its own window
+    for (size_t i = 0; i < input_ptrs.size(); ++i) {
+      std::string suffix = i == 0 ? "" : "_" + std::to_string(i);
+      std::string input_name = "video_input" + suffix;
+      std::string output_name = "video_output" + suffix;
+      pipe.add(input_name, std::move(input_ptrs[i]));
+      if (i == 0) {
+        pipe.add(input_name, "face_detection", face_inference_ptr);
+        pipe.add("face_detection", "emotions_detection",
+                 emotions_inference_ptr);
+        pipe.add("face_detection", "age_gender_detection",
+                 agegender_inference_ptr);
+        pipe.add("face_detection", "headpose_detection",
+                 headpose_inference_ptr);
+      } else {
+        pipe.add(input_name, "face_detection");
+      }
+      pipe.add("emotions_detection", output_name, output_ptrs[i]);
+      pipe.add("age_gender_detection", output_name, output_ptrs[i]);
+      pipe.add("headpose_detection", output_name, output_ptrs[i]);
+      pipe.routeOutput(output_name, input_name);
+    }
+    pipe.setMaxInFlightFrames(FLAGS_n_fr);
+    pipe.setWorkerThreads(FLAGS_n_wk);
+    if (FLAGS_stats > 0) {
+      pipe.setStatisticsDump(std::chrono::seconds(FLAGS_stats), &std::cout);
+    }
     pipe.setCallback();
     pipe.printPipeline();
-    // --------------------------- 5. Run Pipeline ---------------------------------------------------------
-    while (cv::waitKey(1) < 0 && cvGetWindowHandle(window_name.c_str())) {
+    // --------------------------- 6. Run Pipeline ---------------------------------------------------------
+    auto windows_open = [&window_names]() {
+      for (auto &window_name : window_names) {
+        if (!cvGetWindowHandle(window_name.c_str())) return false;
+      }
+      return true;
+    };
+    while (cv::waitKey(1) < 0 && windows_open()) {
       pipe.runOnce();
     }
+    pipe.flush();
+    if (FLAGS_stats > 0) {
+      std::cout << pipe.getProfiler().toText() << std::endl;
+    }
     slog::info << "Execution successful" << slog::endl;
     return 0;
   }
@@ -17,7 +17,7 @@ static const char help_message[] = "Print a usage message.";
 
 /// @brief message for images argument
 static const char video_message[] =
-    "Optional. Path to an video file. Default value is \"cam\" to work with camera.";
+    "Optional. Path to an video file. Default value is \"cam\" to work with camera. Several comma separated inputs share the same networks.";
 
 /// @brief message for model argument
 static const char face_detection_model_message[] =
@@ -65,6 +65,38 @@ static const char num_batch_hp_message[] =
 static const char num_batch_em_message[] =
     "Specify number of maximum simultaneously processed faces for Emotions Detection (default is 16).";
 
+/// @brief message for number of frames processed by the pipeline at the same time
+static const char num_frames_in_flight_message[] =
+    "Specify number of maximum simultaneously processed frames in the pipeline (default is 1).";
+
+/// @brief message for number of infer requests per network
+static const char num_requests_message[] =
+    "Specify number of infer requests created for each network (default is 1).";
+
+/// @brief message for number of worker threads handling the finished requests
+static const char num_workers_message[] =
+    "Specify number of worker threads handling the finished requests, 0 to handle them on the threads of the plugins (default is 1).";
+
+/// @brief message for the number of warm-up inferences
+static const char warm_up_message[] =
+    "Specify number of inferences run on each infer request at startup, before the first frame (default is 1).";
+
+/// @brief message for the batching delay of the secondary networks
+static const char batch_delay_message[] =
+    "Specify time in milliseconds the secondary networks wait to batch the faces of several frames (default is 0, no batching).";
+
+/// @brief message for the number of frames decoded ahead
+static const char prefetch_message[] =
+    "Specify number of frames decoded ahead on a separate thread for each input (default is 0, no prefetching).";
+
+/// @brief message for the prefetch overflow policy
+static const char overflow_message[] =
+    "Specify what to do when the prefetched frames are not taken in time: block, drop_oldest or drop_newest (default is block).";
+
+/// @brief message for the statistics of the pipeline
+static const char statistics_message[] =
+    "Specify interval in seconds to print latency statistics of each stage of the pipeline (default is 0, not printed).";
+
 /// @brief message for performance counters
 static const char
     performance_counter_message[] = "Enables per-layer performance report.";
@@ -138,6 +170,30 @@ DEFINE_uint32(n_hp, 16, num_batch_hp_message);
 /// \brief device the target device for head pose detection on <br>
 DEFINE_uint32(n_em, 16, num_batch_em_message);
 
+/// \brief number of frames processed by the pipeline at the same time <br>
+DEFINE_uint32(n_fr, 1, num_frames_in_flight_message);
+
+/// \brief number of infer requests created for each network <br>
+DEFINE_uint32(n_req, 1, num_requests_message);
+
+/// \brief number of worker threads handling the finished requests <br>
+DEFINE_uint32(n_wk, 1, num_workers_message);
+
+/// \brief number of warm-up inferences on each infer request <br>
+DEFINE_uint32(warm_up, 1, warm_up_message);
+
+/// \brief batching delay of the secondary networks in milliseconds <br>
+DEFINE_uint32(batch_ms, 0, batch_delay_message);
+
+/// \brief number of frames decoded ahead for each input <br>
+DEFINE_uint32(prefetch, 0, prefetch_message);
+
+/// \brief overflow policy of the prefetched frames <br>
+DEFINE_string(overflow, "block", overflow_message);
+
+/// \brief interval in seconds to print the pipeline statistics <br>
+DEFINE_uint32(stats, 0, statistics_message);
+
 /// \brief Enable per-layer performance report
 DEFINE_bool(pc, false, performance_counter_message);
 
@@ -203,6 +259,22 @@ static void showUsage() {
             << std::endl;
   std::cout << "    -n_em \"<num>\"              " << num_batch_em_message
             << std::endl;
+  std::cout << "    -n_fr \"<num>\"              " << num_frames_in_flight_message
+            << std::endl;
+  std::cout << "    -n_req \"<num>\"             " << num_requests_message
+            << std::endl;
+  std::cout << "    -n_wk \"<num>\"              " << num_workers_message
+            << std::endl;
+  std::cout << "    -warm_up \"<num>\"           " << warm_up_message
+            << std::endl;
+  std::cout << "    -batch_ms \"<num>\"          " << batch_delay_message
+            << std::endl;
+  std::cout << "    -prefetch \"<num>\"          " << prefetch_message
+            << std::endl;
+  std::cout << "    -overflow \"<policy>\"       " << overflow_message
+            << std::endl;
+  std::cout << "    -stats \"<sec>\"             " << statistics_message
+            << std::endl;
   std::cout << "    -no_wait                   " << no_wait_for_keypress_message
             << std::endl;
   std::cout << "    -no_show                   " << no_show_processed_video
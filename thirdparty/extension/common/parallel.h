@@ -0,0 +1,137 @@
+/*
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+#pragma once
+
+#include "ext_isa.hpp"
+#include "ext_parallel.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace InferenceEngine {
+namespace Extensions {
+namespace Cpu {
+
+// Elements a thread gets at least. Waking up a thread for less work costs more than it saves,
+// so small loops run on fewer threads and tiny ones on the calling thread.
+const size_t PARALLEL_MIN_WORK_PER_THREAD = 16 * 1024;
+
+// Number of threads for a loop over about `work` elements: the threads of the backend, capped by
+// the thread budget (the global one if budget is 0) and by the work.
+int parallel_get_num_threads(size_t work, int budget = 0);
+
+// The loops are compiled with the flags of the layers using them, so each level gets its own copy
+namespace EXT_ISA_NAMESPACE {
+
+// Splits [0, n) into nthr contiguous chunks as schedule(static) does, chunk ithr is [start, end)
+inline void splitter(int n, int nthr, int ithr, int& start, int& end) {
+    const int chunk = n / nthr;
+    const int rem = n % nthr;
+    start = ithr * chunk + std::min(ithr, rem);
+    end = start + chunk + (ithr < rem ? 1 : 0);
+}
+
+// Calls body(start, end) on the chunks of [0, n), on the calling thread if nthr is 1
+template <typename F>
+void parallel_for_chunks(int nthr, int n, const F& body) {
+    nthr = std::min(nthr, n);
+    if (nthr <= 1) {
+        if (n > 0)
+            body(0, n);
+        return;
+    }
+    getParallelBackend()->run(nthr, [&](int ithr, int nthr) {
+        int start = 0, end = 0;
+        splitter(n, nthr, ithr, start, end);
+        if (start < end)
+            body(start, end);
+    });
+}
+
+template <typename F>
+void parallel_for(int nthr, int D0, const F& body) {
+    parallel_for_chunks(nthr, D0, [&](int start, int end) {
+        for (int d0 = start; d0 < end; d0++)
+            body(d0);
+    });
+}
+
+// Loops over D0 x D1 as one range, like collapse(2)
+template <typename F>
+void parallel_for2d(int nthr, int D0, int D1, const F& body) {
+    parallel_for_chunks(nthr, D0 * D1, [&](int start, int end) {
+        int d0 = start / D1;
+        int d1 = start % D1;
+        for (int i = start; i < end; i++) {
+            body(d0, d1);
+            if (++d1 == D1) {
+                d1 = 0;
+                d0++;
+            }
+        }
+    });
+}
+
+// Loops over D0 x D1 x D2 as one range, like collapse(3)
+template <typename F>
+void parallel_for3d(int nthr, int D0, int D1, int D2, const F& body) {
+    parallel_for_chunks(nthr, D0 * D1 * D2, [&](int start, int end) {
+        int d0 = start / (D1 * D2);
+        int d1 = start / D2 % D1;
+        int d2 = start % D2;
+        for (int i = start; i < end; i++) {
+            body(d0, d1, d2);
+            if (++d2 == D2) {
+                d2 = 0;
+                if (++d1 == D1) {
+                    d1 = 0;
+                    d0++;
+                }
+            }
+        }
+    });
+}
+
+// Sum of body(d0) over [0, D0). Each thread sums its chunk and the partial sums are added in chunk
+// order, so the result only depends on the number of threads, unlike an OpenMP reduction.
+template <typename T, typename F>
+T parallel_sum(int nthr, int D0, T init, const F& body) {
+    nthr = std::min(nthr, D0);
+    if (nthr <= 1) {
+        T sum = T(0);
+        for (int d0 = 0; d0 < D0; d0++)
+            sum += body(d0);
+        return init + sum;
+    }
+    std::vector<T> partial(nthr, T(0));
+    getParallelBackend()->run(nthr, [&](int ithr, int nthr) {
+        int start = 0, end = 0;
+        splitter(D0, nthr, ithr, start, end);
+        T sum = T(0);
+        for (int d0 = start; d0 < end; d0++)
+            sum += body(d0);
+        partial[ithr] = sum;
+    });
+    for (const T& sum : partial)
+        init += sum;
+    return init;
+}
+
+}  // namespace EXT_ISA_NAMESPACE
+}  // namespace Cpu
+}  // namespace Extensions
+}  // namespace InferenceEngine
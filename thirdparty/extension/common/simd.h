@@ -0,0 +1,90 @@
+/*
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+#pragma once
+
+#include <cmath>
+
+#include "ext_isa.hpp"
+
+#if defined(HAVE_SSE) || defined(HAVE_AVX2) || defined(HAVE_AVX512F)
+#include <immintrin.h>
+#endif
+
+namespace InferenceEngine {
+namespace Extensions {
+namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
+
+// Widest float vector of the instruction set the file is built for, a plain float without one.
+// Kernels written with these helpers compile for every level the library is built for.
+#if defined(HAVE_AVX512F)
+typedef __m512 vec_t;
+const int vec_len = 16;
+static inline vec_t vec_load(const float* p) { return _mm512_loadu_ps(p); }
+static inline void vec_store(float* p, vec_t v) { _mm512_storeu_ps(p, v); }
+static inline vec_t vec_zero() { return _mm512_setzero_ps(); }
+static inline vec_t vec_set1(float a) { return _mm512_set1_ps(a); }
+static inline vec_t vec_add(vec_t a, vec_t b) { return _mm512_add_ps(a, b); }
+static inline vec_t vec_sub(vec_t a, vec_t b) { return _mm512_sub_ps(a, b); }
+static inline vec_t vec_mul(vec_t a, vec_t b) { return _mm512_mul_ps(a, b); }
+static inline vec_t vec_div(vec_t a, vec_t b) { return _mm512_div_ps(a, b); }
+static inline vec_t vec_sqrt(vec_t a) { return _mm512_sqrt_ps(a); }
+static inline vec_t vec_fmadd(vec_t a, vec_t b, vec_t c) { return _mm512_fmadd_ps(a, b, c); }
+#elif defined(HAVE_AVX2)
+typedef __m256 vec_t;
+const int vec_len = 8;
+static inline vec_t vec_load(const float* p) { return _mm256_loadu_ps(p); }
+static inline void vec_store(float* p, vec_t v) { _mm256_storeu_ps(p, v); }
+static inline vec_t vec_zero() { return _mm256_setzero_ps(); }
+static inline vec_t vec_set1(float a) { return _mm256_set1_ps(a); }
+static inline vec_t vec_add(vec_t a, vec_t b) { return _mm256_add_ps(a, b); }
+static inline vec_t vec_sub(vec_t a, vec_t b) { return _mm256_sub_ps(a, b); }
+static inline vec_t vec_mul(vec_t a, vec_t b) { return _mm256_mul_ps(a, b); }
+static inline vec_t vec_div(vec_t a, vec_t b) { return _mm256_div_ps(a, b); }
+static inline vec_t vec_sqrt(vec_t a) { return _mm256_sqrt_ps(a); }
+static inline vec_t vec_fmadd(vec_t a, vec_t b, vec_t c) { return _mm256_fmadd_ps(a, b, c); }
+#elif defined(HAVE_SSE)
+typedef __m128 vec_t;
+const int vec_len = 4;
+static inline vec_t vec_load(const float* p) { return _mm_loadu_ps(p); }
+static inline void vec_store(float* p, vec_t v) { _mm_storeu_ps(p, v); }
+static inline vec_t vec_zero() { return _mm_setzero_ps(); }
+static inline vec_t vec_set1(float a) { return _mm_set1_ps(a); }
+static inline vec_t vec_add(vec_t a, vec_t b) { return _mm_add_ps(a, b); }
+static inline vec_t vec_sub(vec_t a, vec_t b) { return _mm_sub_ps(a, b); }
+static inline vec_t vec_mul(vec_t a, vec_t b) { return _mm_mul_ps(a, b); }
+static inline vec_t vec_div(vec_t a, vec_t b) { return _mm_div_ps(a, b); }
+static inline vec_t vec_sqrt(vec_t a) { return _mm_sqrt_ps(a); }
+static inline vec_t vec_fmadd(vec_t a, vec_t b, vec_t c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+#else
+typedef float vec_t;
+const int vec_len = 1;
+static inline vec_t vec_load(const float* p) { return *p; }
+static inline void vec_store(float* p, vec_t v) { *p = v; }
+static inline vec_t vec_zero() { return 0.f; }
+static inline vec_t vec_set1(float a) { return a; }
+static inline vec_t vec_add(vec_t a, vec_t b) { return a + b; }
+static inline vec_t vec_sub(vec_t a, vec_t b) { return a - b; }
+static inline vec_t vec_mul(vec_t a, vec_t b) { return a * b; }
+static inline vec_t vec_div(vec_t a, vec_t b) { return a / b; }
+static inline vec_t vec_sqrt(vec_t a) { return std::sqrt(a); }
+static inline vec_t vec_fmadd(vec_t a, vec_t b, vec_t c) { return a * b + c; }
+#endif
+
+}  // namespace EXT_ISA_NAMESPACE
+}  // namespace Cpu
+}  // namespace Extensions
+}  // namespace InferenceEngine
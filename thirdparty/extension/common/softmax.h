@@ -26,13 +26,17 @@
 #endif
 
 #include <cmath>
-#include <omp.h>
 #include "defs.h"
+#include "parallel.h"
+
+namespace InferenceEngine {
+namespace Extensions {
+namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
 
 static inline
-void softmax_many_batches(const float *src_data, float *dst_data, int B, int C, int H, int W) {
-    #pragma omp parallel for schedule(static)
-    for (int i = 0; i < B * H * W; i++) {
+void softmax_many_batches(const float *src_data, float *dst_data, int B, int C, int H, int W, int nthr) {
+    parallel_for(nthr, B * H * W, [&](int i) {
         const float *psrc = src_data + (i / (H * W)) * C * H * W - (i / (H * W)) * H * W;
         float *pdst = dst_data + (i / (H * W)) * C * H * W - (i / (H * W)) * H * W;
 
@@ -51,15 +55,15 @@ void softmax_many_batches(const float *src_data, float *dst_data, int B, int C,
         for (int c = 0; c < C; c++) {
             pdst[c * H * W + i] = pdst[c * H * W + i] / expSum;
         }
-    }
+    });
 }
 
 static inline
-void softmax_generic(const float *src_data, float *dst_data, int B, int C, int H, int W) {
+void softmax_generic(const float *src_data, float *dst_data, int B, int C, int H, int W, int nthr) {
     for (int b = 0; b < B; b++) {
 #if defined(HAVE_AVX2)
-        #pragma omp parallel for schedule(static)
-        for (int i = 0; i <= H*W - 8; i += 8) {
+        parallel_for(nthr, H*W / 8, [&](int blk) {
+            const int i = blk * 8;
             __m256 vmax = _mm256_loadu_ps(src_data + b*C*H*W + i);
             for (int c = 0; c < C; c++) {
                 __m256 vval = _mm256_loadu_ps(src_data + b*C*H*W + c*H*W + i);
@@ -83,10 +87,10 @@ void softmax_generic(const float *src_data, float *dst_data, int B, int C, int H
                 __m256 vval = _mm256_loadu_ps(dst_data + b*C*H*W + c*H*W + i);
                 _mm256_storeu_ps(dst_data + b*C*H*W + c*H*W + i, _mm256_div_ps(vval, vexpSum));
             }
-        }
+        });
 #elif defined(HAVE_SSE)
-#pragma omp parallel for schedule(static)
-        for (int i = 0; i <= H*W - 4; i += 4) {
+        parallel_for(nthr, H*W / 4, [&](int blk) {
+            const int i = blk * 4;
             __m128 vmax = _mm_loadu_ps(src_data + b*C*H*W + i);
             for (int c = 0; c < C; c++) {
                 __m128 vval = _mm_loadu_ps(src_data + b*C*H*W + c*H*W + i);
@@ -110,7 +114,7 @@ void softmax_generic(const float *src_data, float *dst_data, int B, int C, int H
                 __m128 vval = _mm_loadu_ps(dst_data + b*C*H*W + c*H*W + i);
                 _mm_storeu_ps(dst_data + b*C*H*W + c*H*W + i, _mm_div_ps(vval, vexpSum));
             }
-        }
+        });
 #endif
 
 #if defined(HAVE_AVX2)
@@ -138,4 +142,9 @@ void softmax_generic(const float *src_data, float *dst_data, int B, int C, int H
             }
         }
     }
-}
\ No newline at end of file
+}
+
+}  // namespace EXT_ISA_NAMESPACE
+}  // namespace Cpu
+}  // namespace Extensions
+}  // namespace InferenceEngine
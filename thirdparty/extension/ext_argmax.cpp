@@ -27,6 +27,7 @@
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
 
 class ArgMaxImpl: public ExtLayerBase {
 public:
@@ -118,6 +119,7 @@ private:
 
 REG_FACTORY_FOR(ImplFactory<ArgMaxImpl>, ArgMax);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine
@@ -15,6 +15,7 @@
 */
 
 #include "ext_base.hpp"
+#include "parallel.h"
 
 #include <vector>
 #include <string>
@@ -30,6 +31,22 @@ inline int div_up(const int a, const int b) {
     return (a + b - 1) / b;
 }
 
+ExtLayerBase::ExtLayerBase(const CNNLayer *layer): cnnLayer(*layer) {
+    try {
+        threadBudget = std::max(cnnLayer.GetParamAsInt("parallel_threads", 0), 0);
+    } catch (InferenceEngine::details::InferenceEngineException &ex) {
+        errorMsg = ex.what();
+    }
+}
+
+ExtLayerBase::~ExtLayerBase() = default;
+
+ExtLayerBase::DataConfigurator::DataConfigurator(ConfLayout l):
+    layout(l) {}
+
+ExtLayerBase::DataConfigurator::DataConfigurator(ConfLayout l, bool constant, int inplace):
+        layout(l), constant(constant), inplace(inplace) {}
+
 StatusCode
 ExtLayerBase::getSupportedConfigurations(std::vector<LayerConfig>& conf, ResponseDesc *resp) noexcept {
     if (!errorMsg.empty()) {
@@ -67,6 +84,10 @@ ExtLayerBase::init(LayerConfig& config, ResponseDesc *resp) noexcept {
     return OK;
 }
 
+int ExtLayerBase::parallelThreads(size_t work) const {
+    return parallel_get_num_threads(work, threadBudget);
+}
+
 void ExtLayerBase::addConfig(std::vector<DataConfigurator> in_l, std::vector<DataConfigurator> out_l, bool dynBatchSupport) {
     LayerConfig config;
 
@@ -18,6 +18,8 @@
 
 #include <ie_iextension.h>
 
+#include "ext_isa.hpp"
+
 #include <string>
 #include <vector>
 
@@ -27,7 +29,8 @@ namespace Cpu {
 
 class ExtLayerBase: public ILayerExecImpl {
 public:
-    explicit ExtLayerBase(const CNNLayer *layer): cnnLayer(*layer) {}
+    explicit ExtLayerBase(const CNNLayer *layer);
+    ~ExtLayerBase() override;
 
     StatusCode getSupportedConfigurations(std::vector<LayerConfig>& conf, ResponseDesc *resp) noexcept override;
     StatusCode init(LayerConfig& config, ResponseDesc *resp) noexcept override;
@@ -37,11 +40,9 @@ protected:
 
     class DataConfigurator {
     public:
-        explicit DataConfigurator(ConfLayout l):
-            layout(l) {}
+        explicit DataConfigurator(ConfLayout l);
 
-        DataConfigurator(ConfLayout l, bool constant, int inplace = -1):
-                layout(l), constant(constant), inplace(inplace) {}
+        DataConfigurator(ConfLayout l, bool constant, int inplace = -1);
 
         ConfLayout layout;
         bool constant = false;
@@ -49,9 +50,13 @@ protected:
     };
 
     void addConfig(std::vector<DataConfigurator> in_l, std::vector<DataConfigurator> out_l, bool dynBatchSupport = false);
+    // Threads a parallel loop of the layer over about `work` elements runs on
+    int parallelThreads(size_t work) const;
     std::string errorMsg;
     CNNLayer cnnLayer;
     std::vector<LayerConfig> confs;
+    // Threads the layer runs its loops on at most, from the "parallel_threads" parameter, 0 for the global budget
+    int threadBudget = 0;
 };
 
 template <class IMPL>
@@ -24,6 +24,7 @@
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
 
 class CTCGreedyDecoderImpl: public ExtLayerBase {
 public:
@@ -100,6 +101,7 @@ public:
 
 REG_FACTORY_FOR(ImplFactory<CTCGreedyDecoderImpl>, CTCGreedyDecoder);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine
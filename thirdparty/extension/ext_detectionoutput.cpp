@@ -16,6 +16,9 @@
 
 #include "ext_list.hpp"
 #include "ext_base.hpp"
+#include "parallel.h"
+
+#include "defs.h"
 
 #include <cfloat>
 #include <vector>
@@ -27,11 +30,23 @@
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
+
+struct ScoreIndex {
+    float score;
+    int label;
+    int index;
+};
+
+// Ties keep the order of the classes and of the NMS output
+static bool ScoreIndexDescend(const ScoreIndex& a, const ScoreIndex& b) {
+    if (a.score != b.score) return a.score > b.score;
+    if (a.label != b.label) return a.label < b.label;
+    return a.index < b.index;
+}
 
-template <typename T>
-static bool SortScorePairDescend(const std::pair<float, T>& pair1,
-                                 const std::pair<float, T>& pair2) {
-    return pair1.first > pair2.first;
+static inline int div_up(const int a, const int b) {
+    return (a + b - 1) / b;
 }
 
 class DetectionOutputImpl: public ExtLayerBase {
@@ -58,6 +73,19 @@ public:
             _offset = _normalized ? 0 : 1;
             _num_loc_classes = _share_location ? 1 : _num_classes;
 
+            std::string nms_strategy_str = cnnLayer.GetParamAsString("nms_strategy", "greedy");
+            if (nms_strategy_str == "greedy") {
+                _nms_strategy = NmsStrategy::GREEDY;
+            } else if (nms_strategy_str == "fast") {
+                _nms_strategy = NmsStrategy::FAST;
+            } else if (nms_strategy_str == "matrix") {
+                _nms_strategy = NmsStrategy::MATRIX;
+            } else {
+                THROW_IE_EXCEPTION << "Unsupported nms_strategy " << nms_strategy_str;
+            }
+            _matrix_gaussian = cnnLayer.GetParamAsString("matrix_kernel", "linear") == "gaussian";
+            _matrix_sigma = cnnLayer.GetParamAsFloat("matrix_sigma", 2.0f);
+
             std::string code_type_str = cnnLayer.GetParamAsString("code_type", "caffe.PriorBoxParameter.CORNER");
             _code_type = (code_type_str == "caffe.PriorBoxParameter.CENTER_SIZE" ? CodeType::CENTER_SIZE
                                                                                  : CodeType::CORNER);
@@ -114,6 +142,13 @@ public:
             _num_priors_actual = InferenceEngine::make_shared_blob<int>({Precision::UNSPECIFIED, num_priors_actual_size, C});
             _num_priors_actual->allocate();
 
+            // Every class keeps at most top_k boxes after NMS
+            _class_detections = _top_k == -1 ? _num_priors : std::min(_top_k, _num_priors);
+            _top_k_workspace.resize(static_cast<size_t>(_num_classes) * _class_detections);
+            if (_nms_strategy != NmsStrategy::GREEDY) {
+                _nms_workspace.resize(static_cast<size_t>(_num_classes) * NMS_WORKSPACE_ROWS * _class_detections);
+            }
+
             addConfig({DataConfigurator(ConfLayout::PLN),
                        DataConfigurator(ConfLayout::PLN),
                        DataConfigurator(ConfLayout::PLN)}, {DataConfigurator(ConfLayout::PLN)});
@@ -144,50 +179,54 @@ public:
         const float *ppriors = prior_data;
 
         for (int n = 0; n < N; ++n) {
-            if (_share_location) {
-                const float *ploc = loc_data + n*4*_num_priors;
-                float *pboxes = decoded_bboxes_data + n*4*_num_priors;
-                float *psizes = bbox_sizes_data + n*_num_priors;
-                decodeBBoxes(ppriors, ploc, prior_variances, pboxes, psizes, num_priors_actual, n);
-            } else {
-                for (int c = 0; c < _num_loc_classes; ++c) {
-                    if (c == _background_label_id) {
-                        continue;
-                    }
-
-                    const float *ploc = loc_data + n*4*_num_loc_classes*_num_priors + c*4;
-                    float *pboxes = decoded_bboxes_data + n*4*_num_loc_classes*_num_priors + c*4*_num_priors;
-                    float *psizes = bbox_sizes_data + n*_num_loc_classes*_num_priors + c*_num_priors;
-                    decodeBBoxes(ppriors, ploc, prior_variances, pboxes, psizes, num_priors_actual, n);
-                }
-            }
+            num_priors_actual[n] = countPriors(ppriors);
         }
 
-        for (int n = 0; n < N; ++n) {
-            for (int c = 0; c < _num_classes; ++c) {
-                for (int p = 0; p < _num_priors; ++p) {
-                    reordered_conf_data[n*_num_priors*_num_classes + c*_num_priors + p] = conf_data[n*_num_priors*_num_classes + p*_num_classes + c];
-                }
+        // Priors are decoded and confidences transposed in blocks, so that
+        // all threads get work even for a single image.
+        const int blocks = div_up(_num_priors, BLOCK_SIZE);
+
+        const int decode_nthr = parallelThreads(static_cast<size_t>(N)*_num_loc_classes*_num_priors*4);
+        parallel_for(decode_nthr, N*_num_loc_classes*blocks, [&](int task) {
+            const int n = task / (_num_loc_classes*blocks);
+            const int c = task / blocks % _num_loc_classes;
+            const int start = task % blocks * BLOCK_SIZE;
+            const int end = std::min(start + BLOCK_SIZE, num_priors_actual[n]);
+            if (start >= end || (!_share_location && c == _background_label_id)) {
+                return;
             }
-        }
+
+            const float *ploc = loc_data + n*4*_num_loc_classes*_num_priors + c*4;
+            float *pboxes = decoded_bboxes_data + n*4*_num_loc_classes*_num_priors + c*4*_num_priors;
+            float *psizes = bbox_sizes_data + n*_num_loc_classes*_num_priors + c*_num_priors;
+            decodeBBoxes(ppriors, ploc, prior_variances, pboxes, psizes, start, end);
+        });
+
+        parallel_for(parallelThreads(static_cast<size_t>(N)*_num_priors*_num_classes), N*blocks, [&](int task) {
+            const int n = task / blocks;
+            const int start = task % blocks * BLOCK_SIZE;
+            const int end = std::min(start + BLOCK_SIZE, _num_priors);
+
+            transposeConfidence(conf_data + n*_num_priors*_num_classes,
+                                reordered_conf_data + n*_num_priors*_num_classes, start, end);
+        });
 
         memset(detections_data, 0, N*_num_classes*sizeof(int));
 
         for (int n = 0; n < N; ++n) {
             int detections_total = 0;
 
-#pragma omp parallel for schedule(static)
-            for (int c = 0; c < _num_classes; ++c) {
+            parallel_for(parallelThreads(static_cast<size_t>(_num_classes)*_num_priors), _num_classes, [&](int c) {
                 if (c == _background_label_id) {
                     // Ignore background class.
-                    continue;
+                    return;
                 }
 
                 int *pindices    = indices_data + n*_num_classes*_num_priors + c*_num_priors;
                 int *pbuffer     = buffer_data + c*_num_priors;
                 int *pdetections = detections_data + n*_num_classes + c;
 
-                const float *pconf = reordered_conf_data + n*_num_classes*_num_priors + c*_num_priors;
+                float *pconf = reordered_conf_data + n*_num_classes*_num_priors + c*_num_priors;
                 const float *pboxes;
                 const float *psizes;
                 if (_share_location) {
@@ -198,15 +237,27 @@ public:
                     psizes = bbox_sizes_data + n*_num_classes*_num_priors + c*_num_priors;
                 }
 
-                nms(pconf, pboxes, psizes, pbuffer, pindices, *pdetections, num_priors_actual[n]);
-            }
+                if (_nms_strategy == NmsStrategy::GREEDY) {
+                    nms(pconf, pboxes, psizes, pbuffer, pindices, *pdetections, num_priors_actual[n]);
+                } else {
+                    float *pworkspace = &_nms_workspace[static_cast<size_t>(c) * NMS_WORKSPACE_ROWS * _class_detections];
+                    if (_nms_strategy == NmsStrategy::FAST) {
+                        fastNms(pconf, pboxes, psizes, pbuffer, pindices, pworkspace, *pdetections,
+                                num_priors_actual[n]);
+                    } else {
+                        matrixNms(pconf, pboxes, psizes, pbuffer, pindices, pworkspace, *pdetections,
+                                  num_priors_actual[n]);
+                    }
+                }
+            });
 
             for (int c = 0; c < _num_classes; ++c) {
                 detections_total += detections_data[n*_num_classes + c];
             }
 
             if (_keep_top_k > -1 && detections_total > _keep_top_k) {
-                std::vector<std::pair<float, std::pair<int, int>>> conf_index_class_map;
+                ScoreIndex *candidates = &_top_k_workspace[0];
+                int num_candidates = 0;
 
                 for (int c = 0; c < _num_classes; ++c) {
                     int detections = detections_data[n*_num_classes + c];
@@ -215,20 +266,21 @@ public:
 
                     for (int i = 0; i < detections; ++i) {
                         int idx = pindices[i];
-                        conf_index_class_map.push_back(std::make_pair(pconf[idx], std::make_pair(c, idx)));
+                        candidates[num_candidates++] = {pconf[idx], c, idx};
                     }
                 }
 
-                std::sort(conf_index_class_map.begin(), conf_index_class_map.end(),
-                          SortScorePairDescend<std::pair<int, int>>);
-                conf_index_class_map.resize(_keep_top_k);
+                // Select the best ones first, then sort only them.
+                std::nth_element(candidates, candidates + _keep_top_k - 1,
+                                 candidates + num_candidates, ScoreIndexDescend);
+                std::sort(candidates, candidates + _keep_top_k, ScoreIndexDescend);
 
                 // Store the new indices.
                 memset(detections_data + n*_num_classes, 0, _num_classes * sizeof(int));
 
-                for (int j = 0; j < conf_index_class_map.size(); ++j) {
-                    int label = conf_index_class_map[j].second.first;
-                    int idx = conf_index_class_map[j].second.second;
+                for (int j = 0; j < _keep_top_k; ++j) {
+                    int label = candidates[j].label;
+                    int idx = candidates[j].index;
                     int *pindices = indices_data + n * _num_classes * _num_priors + label * _num_priors;
                     pindices[detections_data[n*_num_classes + label]] = idx;
                     detections_data[n*_num_classes + label]++;
@@ -325,12 +377,44 @@ private:
         CENTER_SIZE = 2,
     };
 
+    // greedy: pairwise overlaps with the kept boxes
+    // fast: the same result, overlaps computed 8 boxes at a time
+    // matrix: scores decayed by the overlaps with all better boxes, no serial dependency
+    enum class NmsStrategy {
+        GREEDY,
+        FAST,
+        MATRIX,
+    };
+
+    NmsStrategy _nms_strategy = NmsStrategy::GREEDY;
+    bool _matrix_gaussian = false;
+    float _matrix_sigma = 2.0f;
+    int _class_detections = 0;
+
+    // Boxes as xmin, ymin, xmax, ymax and size rows, plus three rows for matrix NMS
+    static const int NMS_WORKSPACE_ROWS = 8;
+
+    // Priors decoded and confidences transposed by one task
+    static const int BLOCK_SIZE = 512;
+
+    int countPriors(const float *prior_data);
+
     void decodeBBoxes(const float *prior_data, const float *loc_data, const float *variance_data,
-                      float *decoded_bboxes, float *decoded_bbox_sizes, int* num_priors_actual, int n);
+                      float *decoded_bboxes, float *decoded_bbox_sizes, int start, int end);
+
+    void transposeConfidence(const float *conf_data, float *reordered_conf_data, int start, int end);
+
+    int selectCandidates(const float *conf_data, int *buffer, int *indices, int num_priors_actual);
 
     void nms(const float *conf_data, const float *bboxes, const float *sizes,
              int *buffer, int *indices, int &detections, int num_priors_actual);
 
+    void fastNms(const float *conf_data, const float *bboxes, const float *sizes,
+                 int *buffer, int *indices, float *workspace, int &detections, int num_priors_actual);
+
+    void matrixNms(float *conf_data, const float *bboxes, const float *sizes,
+                   int *buffer, int *indices, float *workspace, int &detections, int num_priors_actual);
+
     InferenceEngine::Blob::Ptr _decoded_bboxes;
     InferenceEngine::Blob::Ptr _buffer;
     InferenceEngine::Blob::Ptr _indices;
@@ -338,6 +422,9 @@ private:
     InferenceEngine::Blob::Ptr _reordered_conf;
     InferenceEngine::Blob::Ptr _bbox_sizes;
     InferenceEngine::Blob::Ptr _num_priors_actual;
+
+    std::vector<ScoreIndex> _top_k_workspace;
+    std::vector<float> _nms_workspace;
 };
 
 struct ConfidenceComparator {
@@ -389,27 +476,137 @@ static inline float JaccardOverlap(const float *decoded_bbox,
     return intersect_size / (bbox1_size + bbox2_size - intersect_size);
 }
 
+int DetectionOutputImpl::countPriors(const float *prior_data) {
+    if (!_normalized) {
+        for (int num = 0; num < _num_priors; ++num) {
+            float batch_id = prior_data[num * _prior_size + 0];
+            if (batch_id == -1.f) {
+                return num;
+            }
+        }
+    }
+    return _num_priors;
+}
+
+#if defined(HAVE_AVX2)
+// Load 8 boxes stored as [xmin, ymin, xmax, ymax] into one register per coordinate
+static inline void load_boxes_avx2(const float *src, __m256 &xmin, __m256 &ymin, __m256 &xmax, __m256 &ymax) {
+    __m256 m0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 0)), _mm_loadu_ps(src + 16), 1);
+    __m256 m1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 4)), _mm_loadu_ps(src + 20), 1);
+    __m256 m2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 8)), _mm_loadu_ps(src + 24), 1);
+    __m256 m3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 12)), _mm_loadu_ps(src + 28), 1);
+
+    __m256 t0 = _mm256_unpacklo_ps(m0, m1);
+    __m256 t1 = _mm256_unpacklo_ps(m2, m3);
+    __m256 t2 = _mm256_unpackhi_ps(m0, m1);
+    __m256 t3 = _mm256_unpackhi_ps(m2, m3);
+
+    xmin = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+    ymin = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+    xmax = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    ymax = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+// Exponent of each lane with std::exp, like the scalar decode: the decoded boxes, and therefore the boxes kept by
+// the NMS, must not depend on the ISA level or on where a prior falls in its block
+static inline __m256 exp_avx2(__m256 v) {
+    float values[8];
+    _mm256_storeu_ps(values, v);
+    for (int i = 0; i < 8; ++i)
+        values[i] = std::exp(values[i]);
+    return _mm256_loadu_ps(values);
+}
+
+static inline void store_boxes_avx2(float *dst, __m256 xmin, __m256 ymin, __m256 xmax, __m256 ymax) {
+    __m256 t0 = _mm256_unpacklo_ps(xmin, ymin);
+    __m256 t1 = _mm256_unpackhi_ps(xmin, ymin);
+    __m256 t2 = _mm256_unpacklo_ps(xmax, ymax);
+    __m256 t3 = _mm256_unpackhi_ps(xmax, ymax);
+
+    __m256 m0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 m1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 m2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 m3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+    _mm_storeu_ps(dst + 0,  _mm256_castps256_ps128(m0));
+    _mm_storeu_ps(dst + 4,  _mm256_castps256_ps128(m1));
+    _mm_storeu_ps(dst + 8,  _mm256_castps256_ps128(m2));
+    _mm_storeu_ps(dst + 12, _mm256_castps256_ps128(m3));
+    _mm_storeu_ps(dst + 16, _mm256_extractf128_ps(m0, 1));
+    _mm_storeu_ps(dst + 20, _mm256_extractf128_ps(m1, 1));
+    _mm_storeu_ps(dst + 24, _mm256_extractf128_ps(m2, 1));
+    _mm_storeu_ps(dst + 28, _mm256_extractf128_ps(m3, 1));
+}
+#endif
+
 void DetectionOutputImpl::decodeBBoxes(const float *prior_data,
                                    const float *loc_data,
                                    const float *variance_data,
                                    float *decoded_bboxes,
                                    float *decoded_bbox_sizes,
-                                   int* num_priors_actual,
-                                   int n) {
-    num_priors_actual[n] = _num_priors;
-    if (!_normalized) {
-        int num = 0;
-        for (; num < _num_priors; ++num) {
-            float batch_id = prior_data[num * _prior_size + 0];
-            if (batch_id == -1.f) {
-                num_priors_actual[n] = num;
-                break;
+                                   int start,
+                                   int end) {
+    int p = start;
+#if defined(HAVE_AVX2)
+    // Normalized priors and shared locations are stored as plain boxes
+    if (_normalized && _num_loc_classes == 1) {
+        const __m256 vhalf = _mm256_set1_ps(0.5f);
+        const __m256 vzero = _mm256_setzero_ps();
+        const __m256 vone = _mm256_set1_ps(1.0f);
+
+        for (; p <= end - 8; p += 8) {
+            __m256 prior_xmin, prior_ymin, prior_xmax, prior_ymax;
+            __m256 loc_xmin, loc_ymin, loc_xmax, loc_ymax;
+            load_boxes_avx2(prior_data + p*4, prior_xmin, prior_ymin, prior_xmax, prior_ymax);
+            load_boxes_avx2(loc_data + p*4, loc_xmin, loc_ymin, loc_xmax, loc_ymax);
+
+            if (!_variance_encoded_in_target) {
+                __m256 var_xmin, var_ymin, var_xmax, var_ymax;
+                load_boxes_avx2(variance_data + p*4, var_xmin, var_ymin, var_xmax, var_ymax);
+                loc_xmin = _mm256_mul_ps(var_xmin, loc_xmin);
+                loc_ymin = _mm256_mul_ps(var_ymin, loc_ymin);
+                loc_xmax = _mm256_mul_ps(var_xmax, loc_xmax);
+                loc_ymax = _mm256_mul_ps(var_ymax, loc_ymax);
             }
+
+            __m256 new_xmin, new_ymin, new_xmax, new_ymax;
+            if (_code_type == CodeType::CENTER_SIZE) {
+                __m256 prior_width    = _mm256_sub_ps(prior_xmax, prior_xmin);
+                __m256 prior_height   = _mm256_sub_ps(prior_ymax, prior_ymin);
+                __m256 prior_center_x = _mm256_mul_ps(_mm256_add_ps(prior_xmin, prior_xmax), vhalf);
+                __m256 prior_center_y = _mm256_mul_ps(_mm256_add_ps(prior_ymin, prior_ymax), vhalf);
+
+                __m256 center_x = _mm256_add_ps(_mm256_mul_ps(loc_xmin, prior_width), prior_center_x);
+                __m256 center_y = _mm256_add_ps(_mm256_mul_ps(loc_ymin, prior_height), prior_center_y);
+                __m256 half_width  = _mm256_mul_ps(_mm256_mul_ps(exp_avx2(loc_xmax), prior_width), vhalf);
+                __m256 half_height = _mm256_mul_ps(_mm256_mul_ps(exp_avx2(loc_ymax), prior_height), vhalf);
+
+                new_xmin = _mm256_sub_ps(center_x, half_width);
+                new_ymin = _mm256_sub_ps(center_y, half_height);
+                new_xmax = _mm256_add_ps(center_x, half_width);
+                new_ymax = _mm256_add_ps(center_y, half_height);
+            } else {
+                new_xmin = _mm256_add_ps(prior_xmin, loc_xmin);
+                new_ymin = _mm256_add_ps(prior_ymin, loc_ymin);
+                new_xmax = _mm256_add_ps(prior_xmax, loc_xmax);
+                new_ymax = _mm256_add_ps(prior_ymax, loc_ymax);
+            }
+
+            if (_clip) {
+                new_xmin = _mm256_max_ps(vzero, _mm256_min_ps(vone, new_xmin));
+                new_ymin = _mm256_max_ps(vzero, _mm256_min_ps(vone, new_ymin));
+                new_xmax = _mm256_max_ps(vzero, _mm256_min_ps(vone, new_xmax));
+                new_ymax = _mm256_max_ps(vzero, _mm256_min_ps(vone, new_ymax));
+            }
+
+            store_boxes_avx2(decoded_bboxes + p*4, new_xmin, new_ymin, new_xmax, new_ymax);
+            _mm256_storeu_ps(decoded_bbox_sizes + p, _mm256_mul_ps(_mm256_sub_ps(new_xmax, new_xmin),
+                                                                   _mm256_sub_ps(new_ymax, new_ymin)));
         }
     }
+#endif
 
-    #pragma omp parallel for schedule(static)
-    for (int p = 0; p < num_priors_actual[n]; ++p) {
+    for (; p < end; ++p) {
         float new_xmin = 0.0f;
         float new_ymin = 0.0f;
         float new_xmax = 0.0f;
@@ -490,13 +687,33 @@ void DetectionOutputImpl::decodeBBoxes(const float *prior_data,
     }
 }
 
-void DetectionOutputImpl::nms(const float* conf_data,
-                          const float* bboxes,
-                          const float* sizes,
-                          int* buffer,
-                          int* indices,
-                          int& detections,
-                          int num_priors_actual) {
+void DetectionOutputImpl::transposeConfidence(const float *conf_data,
+                                              float *reordered_conf_data,
+                                              int start,
+                                              int end) {
+    int p = start;
+#if defined(HAVE_AVX2)
+    // Gather one class of 8 priors at a time
+    const __m256i vindex = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                              _mm256_set1_epi32(_num_classes));
+    for (; p <= end - 8; p += 8) {
+        const float *pconf = conf_data + p*_num_classes;
+        for (int c = 0; c < _num_classes; ++c) {
+            _mm256_storeu_ps(reordered_conf_data + c*_num_priors + p, _mm256_i32gather_ps(pconf + c, vindex, 4));
+        }
+    }
+#endif
+    for (; p < end; ++p) {
+        for (int c = 0; c < _num_classes; ++c) {
+            reordered_conf_data[c*_num_priors + p] = conf_data[p*_num_classes + c];
+        }
+    }
+}
+
+int DetectionOutputImpl::selectCandidates(const float* conf_data,
+                                          int* buffer,
+                                          int* indices,
+                                          int num_priors_actual) {
     int count = 0;
     for (int i = 0; i < num_priors_actual; ++i) {
         if (conf_data[i] > _confidence_threshold) {
@@ -510,6 +727,17 @@ void DetectionOutputImpl::nms(const float* conf_data,
     std::partial_sort_copy(indices, indices + count,
                            buffer, buffer + num_output_scores,
                            ConfidenceComparator(conf_data));
+    return num_output_scores;
+}
+
+void DetectionOutputImpl::nms(const float* conf_data,
+                          const float* bboxes,
+                          const float* sizes,
+                          int* buffer,
+                          int* indices,
+                          int& detections,
+                          int num_priors_actual) {
+    int num_output_scores = selectCandidates(conf_data, buffer, indices, num_priors_actual);
 
     for (int i = 0; i < num_output_scores; ++i) {
         const int idx = buffer[i];
@@ -530,8 +758,155 @@ void DetectionOutputImpl::nms(const float* conf_data,
     }
 }
 
+// Boxes of one class stored by coordinate, so that overlaps are computed 8 at a time
+struct BoxRows {
+    BoxRows(float *workspace, int stride):
+        xmin(workspace), ymin(workspace + stride), xmax(workspace + 2*stride),
+        ymax(workspace + 3*stride), size(workspace + 4*stride) {}
+
+    void set(int i, const float *bboxes, const float *sizes, int idx) {
+        xmin[i] = bboxes[idx*4 + 0];
+        ymin[i] = bboxes[idx*4 + 1];
+        xmax[i] = bboxes[idx*4 + 2];
+        ymax[i] = bboxes[idx*4 + 3];
+        size[i] = sizes[idx];
+    }
+
+    float *xmin;
+    float *ymin;
+    float *xmax;
+    float *ymax;
+    float *size;
+};
+
+// Same arithmetic as JaccardOverlap, so the fast NMS keeps the same boxes
+static inline float JaccardOverlap(const BoxRows &rows, int i, int j) {
+    float intersect_width  = std::min(rows.xmax[i], rows.xmax[j]) - std::max(rows.xmin[i], rows.xmin[j]);
+    float intersect_height = std::min(rows.ymax[i], rows.ymax[j]) - std::max(rows.ymin[i], rows.ymin[j]);
+
+    if (intersect_width <= 0 || intersect_height <= 0) {
+        return 0.0f;
+    }
+
+    float intersect_size = intersect_width * intersect_height;
+    return intersect_size / (rows.size[i] + rows.size[j] - intersect_size);
+}
+
+#if defined(HAVE_AVX2)
+// Overlaps of box i with the boxes [j, j + 8)
+static inline __m256 JaccardOverlap8(const BoxRows &rows, int i, int j) {
+    __m256 intersect_width = _mm256_sub_ps(
+            _mm256_min_ps(_mm256_set1_ps(rows.xmax[i]), _mm256_loadu_ps(rows.xmax + j)),
+            _mm256_max_ps(_mm256_set1_ps(rows.xmin[i]), _mm256_loadu_ps(rows.xmin + j)));
+    __m256 intersect_height = _mm256_sub_ps(
+            _mm256_min_ps(_mm256_set1_ps(rows.ymax[i]), _mm256_loadu_ps(rows.ymax + j)),
+            _mm256_max_ps(_mm256_set1_ps(rows.ymin[i]), _mm256_loadu_ps(rows.ymin + j)));
+
+    __m256 vzero = _mm256_setzero_ps();
+    __m256 valid = _mm256_and_ps(_mm256_cmp_ps(intersect_width, vzero, _CMP_GT_OQ),
+                                 _mm256_cmp_ps(intersect_height, vzero, _CMP_GT_OQ));
+
+    __m256 intersect_size = _mm256_mul_ps(intersect_width, intersect_height);
+    __m256 union_size = _mm256_sub_ps(_mm256_add_ps(_mm256_set1_ps(rows.size[i]), _mm256_loadu_ps(rows.size + j)),
+                                      intersect_size);
+    return _mm256_and_ps(valid, _mm256_div_ps(intersect_size, union_size));
+}
+#endif
+
+void DetectionOutputImpl::fastNms(const float* conf_data,
+                              const float* bboxes,
+                              const float* sizes,
+                              int* buffer,
+                              int* indices,
+                              float* workspace,
+                              int& detections,
+                              int num_priors_actual) {
+    int num_output_scores = selectCandidates(conf_data, buffer, indices, num_priors_actual);
+
+    // Candidates are appended after the kept boxes and dropped again if they overlap
+    BoxRows rows(workspace, _class_detections);
+    for (int i = 0; i < num_output_scores; ++i) {
+        const int idx = buffer[i];
+        rows.set(detections, bboxes, sizes, idx);
+
+        bool keep = true;
+        int k = 0;
+#if defined(HAVE_AVX2)
+        const __m256 vthreshold = _mm256_set1_ps(_nms_threshold);
+        for (; keep && k <= detections - 8; k += 8) {
+            __m256 overlap = JaccardOverlap8(rows, detections, k);
+            keep = _mm256_movemask_ps(_mm256_cmp_ps(overlap, vthreshold, _CMP_GT_OQ)) == 0;
+        }
+#endif
+        for (; keep && k < detections; ++k) {
+            keep = !(JaccardOverlap(rows, detections, k) > _nms_threshold);
+        }
+        if (keep) {
+            indices[detections] = idx;
+            detections++;
+        }
+    }
+}
+
+void DetectionOutputImpl::matrixNms(float* conf_data,
+                                const float* bboxes,
+                                const float* sizes,
+                                int* buffer,
+                                int* indices,
+                                float* workspace,
+                                int& detections,
+                                int num_priors_actual) {
+    int num_output_scores = selectCandidates(conf_data, buffer, indices, num_priors_actual);
+
+    BoxRows rows(workspace, _class_detections);
+    float *max_overlaps = workspace + 5*_class_detections;
+    float *overlaps = workspace + 6*_class_detections;
+    float *scores = workspace + 7*_class_detections;
+    for (int i = 0; i < num_output_scores; ++i) {
+        rows.set(i, bboxes, sizes, buffer[i]);
+    }
+
+    // Each box is decayed by its overlap with every better box, compensated by how much
+    // that better box is suppressed itself. Nothing depends on which boxes are kept.
+    for (int i = 0; i < num_output_scores; ++i) {
+        int j = 0;
+#if defined(HAVE_AVX2)
+        for (; j <= i - 8; j += 8) {
+            _mm256_storeu_ps(overlaps + j, JaccardOverlap8(rows, i, j));
+        }
+#endif
+        for (; j < i; ++j) {
+            overlaps[j] = JaccardOverlap(rows, i, j);
+        }
+
+        float max_overlap = 0.0f;
+        float decay = 1.0f;
+        for (j = 0; j < i; ++j) {
+            max_overlap = std::max(max_overlap, overlaps[j]);
+            float box_decay = _matrix_gaussian ?
+                    std::exp(-_matrix_sigma * (overlaps[j]*overlaps[j] - max_overlaps[j]*max_overlaps[j])) :
+                    (1.0f - overlaps[j]) / std::max(1.0f - max_overlaps[j], FLT_EPSILON);
+            decay = std::min(decay, box_decay);
+        }
+        max_overlaps[i] = max_overlap;
+        scores[i] = conf_data[buffer[i]] * decay;
+    }
+
+    // Decayed scores are reported, and ordered by keep_top_k
+    for (int i = 0; i < num_output_scores; ++i) {
+        const int idx = buffer[i];
+        conf_data[idx] = scores[i];
+        if (scores[i] > _confidence_threshold) {
+            indices[detections] = idx;
+            detections++;
+        }
+    }
+    std::sort(indices, indices + detections, ConfidenceComparator(conf_data));
+}
+
 REG_FACTORY_FOR(ImplFactory<DetectionOutputImpl>, DetectionOutput);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine
@@ -16,6 +16,8 @@
 
 #include "ext_list.hpp"
 #include "ext_base.hpp"
+#include "parallel.h"
+#include "simd.h"
 
 #include <cmath>
 #include <string>
@@ -24,6 +26,35 @@
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
+
+// Positions normalized at once. Reading a few cache lines of every channel in a row keeps the
+// prefetcher busy, while the lines of all channels still fit into the cache for the second read.
+const int grn_lanes = 64;
+
+// Normalizes L neighbouring positions over C channels that are stride floats apart.
+// The squares of all channels are read before anything is written, so dst may be src.
+template <int L>
+void grn_normalize(const float* src, float* dst, int C, size_t stride, float bias) {
+    const int nvec = L / vec_len;
+    vec_t vsum[nvec];
+    for (int v = 0; v < nvec; v++)
+        vsum[v] = vec_zero();
+    for (int c = 0; c < C; c++) {
+        for (int v = 0; v < nvec; v++) {
+            vec_t x = vec_load(src + c*stride + v*vec_len);
+            vsum[v] = vec_fmadd(x, x, vsum[v]);
+        }
+    }
+
+    vec_t vinv[nvec];
+    for (int v = 0; v < nvec; v++)
+        vinv[v] = vec_div(vec_set1(1.f), vec_sqrt(vec_add(vsum[v], vec_set1(bias))));
+    for (int c = 0; c < C; c++) {
+        for (int v = 0; v < nvec; v++)
+            vec_store(dst + c*stride + v*vec_len, vec_mul(vec_load(src + c*stride + v*vec_len), vinv[v]));
+    }
+}
 
 class GRNImpl: public ExtLayerBase {
 public:
@@ -42,7 +73,7 @@ public:
 
     StatusCode execute(std::vector<Blob::Ptr>& inputs, std::vector<Blob::Ptr>& outputs,
                        ResponseDesc *resp) noexcept override {
-        float* src_data = inputs[0]->buffer();
+        const float* src_data = inputs[0]->buffer();
         float* dst_data = outputs[0]->buffer();
 
         SizeVector dims = inputs[0]->getTensorDesc().getDims();
@@ -52,25 +83,29 @@ public:
         int H = static_cast<int>((dims.size() > 2) ? dims[2] : 1);
         int W = static_cast<int>((dims.size() > 3) ? dims[3] : 1);
 
-#if _MSC_VER && !__INTEL_COMPILER
-        #pragma omp parallel for schedule(static)
-#else
-        #pragma omp parallel for collapse(3) schedule(static)
-#endif
-        for (int b = 0; b < N; b++) {
-            for (int h = 0; h < H; h++) {
-                for (int w = 0; w < W; w++) {
-                    double variance = 0;
-                    for (int c = 0; c < C; c++) {
-                        variance += std::pow(src_data[b*C*H*W + c*H*W + h*W + w], 2);
-                    }
-                    variance = std::pow(variance + bias, 0.5f);
-                    for (int c = 0; c < C; c++) {
-                        dst_data[b*C*H*W + c*H*W + h*W + w] = src_data[b*C*H*W + c*H*W + h*W + w] / variance;
-                    }
-                }
+        const size_t HW = static_cast<size_t>(H) * W;
+        const int groups = static_cast<int>((HW + grn_lanes - 1) / grn_lanes);
+
+        parallel_for2d(parallelThreads(static_cast<size_t>(N)*C*H*W), N, groups, [&](int b, int g) {
+            const size_t start = static_cast<size_t>(g) * grn_lanes;
+            const float* src = src_data + static_cast<size_t>(b) * C * HW;
+            float* dst = dst_data + static_cast<size_t>(b) * C * HW;
+            if (start + grn_lanes <= HW) {
+                grn_normalize<grn_lanes>(src + start, dst + start, C, HW, bias);
+                return;
             }
-        }
+            size_t i = start;
+            for (; i + vec_len <= HW; i += vec_len)
+                grn_normalize<vec_len>(src + i, dst + i, C, HW, bias);
+            for (; i < HW; i++) {
+                float sum = 0.f;
+                for (int c = 0; c < C; c++)
+                    sum += src[c*HW + i] * src[c*HW + i];
+                float inv = 1.f / std::sqrt(sum + bias);
+                for (int c = 0; c < C; c++)
+                    dst[c*HW + i] = src[c*HW + i] * inv;
+            }
+        });
         return OK;
     }
 
@@ -80,6 +115,7 @@ private:
 
 REG_FACTORY_FOR(ImplFactory<GRNImpl>, GRN);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine
@@ -16,12 +16,14 @@
 
 #include "ext_list.hpp"
 #include "ext_base.hpp"
+#include "parallel.h"
 #include <vector>
 #include <immintrin.h>
 
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
 
 class InterpImpl: public ExtLayerBase {
 public:
@@ -98,111 +100,104 @@ private:
 
         int CH = (C + block_size - 1) / block_size;
 
-#if _MSC_VER && !__INTEL_COMPILER
-        #pragma omp parallel for schedule(static)
-#else
-        #pragma omp parallel for collapse(3) schedule(static)
-#endif
-        for (int n = 0; n < N; n++) {
-            for (int cb = 0; cb < CH; ++cb) {
-                for (int h = 0; h < OH_pad; ++h) {
-                    const float *psrc = src + n * CB * IH * IW;
-
-                    float fh = rh * h;
-                    int ih0 = static_cast<int>(fh);
-                    int ih1 = (ih0 < IH_pad - 1) ? ih0 + 1 : ih0;
-
-                    float h_lambda0 = fh - ih0;
-                    float h_lambda1 = 1.0f - h_lambda0;
-
-                    for (int w = 0; w < OW_pad; ++w) {
-                        float fw = rw * w;
-                        int iw0 = static_cast<int>(fw);
-                        int iw1 = (iw0 < IW_pad - 1) ? iw0 + 1 : iw0;
-
-                        float w_lambda0 = fw - iw0;
-                        float w_lambda1 = 1.0f - w_lambda0;
-
-                        const float *psrc00 =
-                                psrc + cb * block_size * IW * IH + (y1 + ih0) * IW * block_size + (x1 + iw0) * block_size;
-                        const float *psrc01 =
-                                psrc + cb * block_size * IW * IH + (y1 + ih0) * IW * block_size + (x1 + iw1) * block_size;
-                        const float *psrc10 =
-                                psrc + cb * block_size * IW * IH + (y1 + ih1) * IW * block_size + (x1 + iw0) * block_size;
-                        const float *psrc11 =
-                                psrc + cb * block_size * IW * IH + (y1 + ih1) * IW * block_size + (x1 + iw1) * block_size;
-
-                        float *pdst = dst + n * CB * OH * OW + cb * block_size * OW * OH + (y2 + h) * OW * block_size +
-                                      (x2 + w) * block_size;
+        const int nthr = parallelThreads(static_cast<size_t>(N) * CB * OH_pad * OW_pad);
+        parallel_for3d(nthr, N, CH, OH_pad, [&](int n, int cb, int h) {
+            const float *psrc = src + n * CB * IH * IW;
+
+            float fh = rh * h;
+            int ih0 = static_cast<int>(fh);
+            int ih1 = (ih0 < IH_pad - 1) ? ih0 + 1 : ih0;
+
+            float h_lambda0 = fh - ih0;
+            float h_lambda1 = 1.0f - h_lambda0;
+
+            for (int w = 0; w < OW_pad; ++w) {
+                float fw = rw * w;
+                int iw0 = static_cast<int>(fw);
+                int iw1 = (iw0 < IW_pad - 1) ? iw0 + 1 : iw0;
+
+                float w_lambda0 = fw - iw0;
+                float w_lambda1 = 1.0f - w_lambda0;
+
+                const float *psrc00 =
+                        psrc + cb * block_size * IW * IH + (y1 + ih0) * IW * block_size + (x1 + iw0) * block_size;
+                const float *psrc01 =
+                        psrc + cb * block_size * IW * IH + (y1 + ih0) * IW * block_size + (x1 + iw1) * block_size;
+                const float *psrc10 =
+                        psrc + cb * block_size * IW * IH + (y1 + ih1) * IW * block_size + (x1 + iw0) * block_size;
+                const float *psrc11 =
+                        psrc + cb * block_size * IW * IH + (y1 + ih1) * IW * block_size + (x1 + iw1) * block_size;
+
+                float *pdst = dst + n * CB * OH * OW + cb * block_size * OW * OH + (y2 + h) * OW * block_size +
+                              (x2 + w) * block_size;
 
 #if defined(HAVE_AVX512F)
-                        __m512 vwl0 = _mm512_set1_ps(w_lambda0);
-                        __m512 vwl1 = _mm512_set1_ps(w_lambda1);
-                        __m512 vhl0 = _mm512_set1_ps(h_lambda0);
-                        __m512 vhl1 = _mm512_set1_ps(h_lambda1);
-                        __m512 vsrc00 = _mm512_loadu_ps(psrc00);
-                        __m512 vsrc01 = _mm512_loadu_ps(psrc01);
-                        __m512 vsrc10 = _mm512_loadu_ps(psrc10);
-                        __m512 vsrc11 = _mm512_loadu_ps(psrc11);
-
-                        __m512 vdst0 = _mm512_fmadd_ps(vwl1, vsrc00, _mm512_mul_ps(vwl0, vsrc01));
-                        __m512 vdst1 = _mm512_fmadd_ps(vwl1, vsrc10, _mm512_mul_ps(vwl0, vsrc11));
-                        __m512 vdst  = _mm512_fmadd_ps(vhl1, vdst0, _mm512_mul_ps(vhl0, vdst1));
-
-                        _mm512_storeu_ps(pdst, vdst);
+                __m512 vwl0 = _mm512_set1_ps(w_lambda0);
+                __m512 vwl1 = _mm512_set1_ps(w_lambda1);
+                __m512 vhl0 = _mm512_set1_ps(h_lambda0);
+                __m512 vhl1 = _mm512_set1_ps(h_lambda1);
+                __m512 vsrc00 = _mm512_loadu_ps(psrc00);
+                __m512 vsrc01 = _mm512_loadu_ps(psrc01);
+                __m512 vsrc10 = _mm512_loadu_ps(psrc10);
+                __m512 vsrc11 = _mm512_loadu_ps(psrc11);
+
+                __m512 vdst0 = _mm512_fmadd_ps(vwl1, vsrc00, _mm512_mul_ps(vwl0, vsrc01));
+                __m512 vdst1 = _mm512_fmadd_ps(vwl1, vsrc10, _mm512_mul_ps(vwl0, vsrc11));
+                __m512 vdst  = _mm512_fmadd_ps(vhl1, vdst0, _mm512_mul_ps(vhl0, vdst1));
+
+                _mm512_storeu_ps(pdst, vdst);
 #elif defined(HAVE_AVX2)
-                        __m256 vwl0 = _mm256_set1_ps(w_lambda0);
-                        __m256 vwl1 = _mm256_set1_ps(w_lambda1);
-                        __m256 vhl0 = _mm256_set1_ps(h_lambda0);
-                        __m256 vhl1 = _mm256_set1_ps(h_lambda1);
-                        __m256 vsrc00 = _mm256_loadu_ps(psrc00);
-                        __m256 vsrc01 = _mm256_loadu_ps(psrc01);
-                        __m256 vsrc10 = _mm256_loadu_ps(psrc10);
-                        __m256 vsrc11 = _mm256_loadu_ps(psrc11);
-
-                       __m256 vdst0 = _mm256_fmadd_ps(vwl1, vsrc00, _mm256_mul_ps(vwl0, vsrc01));
-                       __m256 vdst1 = _mm256_fmadd_ps(vwl1, vsrc10, _mm256_mul_ps(vwl0, vsrc11));
-                       __m256 vdst  = _mm256_fmadd_ps(vhl1, vdst0, _mm256_mul_ps(vhl0, vdst1));
-
-                       _mm256_storeu_ps(pdst, vdst);
+                __m256 vwl0 = _mm256_set1_ps(w_lambda0);
+                __m256 vwl1 = _mm256_set1_ps(w_lambda1);
+                __m256 vhl0 = _mm256_set1_ps(h_lambda0);
+                __m256 vhl1 = _mm256_set1_ps(h_lambda1);
+                __m256 vsrc00 = _mm256_loadu_ps(psrc00);
+                __m256 vsrc01 = _mm256_loadu_ps(psrc01);
+                __m256 vsrc10 = _mm256_loadu_ps(psrc10);
+                __m256 vsrc11 = _mm256_loadu_ps(psrc11);
+
+               __m256 vdst0 = _mm256_fmadd_ps(vwl1, vsrc00, _mm256_mul_ps(vwl0, vsrc01));
+               __m256 vdst1 = _mm256_fmadd_ps(vwl1, vsrc10, _mm256_mul_ps(vwl0, vsrc11));
+               __m256 vdst  = _mm256_fmadd_ps(vhl1, vdst0, _mm256_mul_ps(vhl0, vdst1));
+
+               _mm256_storeu_ps(pdst, vdst);
 #elif defined(HAVE_SSE)
-                        __m128 vwl0 = _mm_set1_ps(w_lambda0);
-                        __m128 vwl1 = _mm_set1_ps(w_lambda1);
-                        __m128 vhl0 = _mm_set1_ps(h_lambda0);
-                        __m128 vhl1 = _mm_set1_ps(h_lambda1);
-                        for (int i = 0; i < block_size/4; i++) {
-                            __m128 vsrc00 = _mm_loadu_ps(psrc00 + i*block_size/2);
-                            __m128 vsrc01 = _mm_loadu_ps(psrc01 + i*block_size/2);
-                            __m128 vsrc10 = _mm_loadu_ps(psrc10 + i*block_size/2);
-                            __m128 vsrc11 = _mm_loadu_ps(psrc11 + i*block_size/2);
-
-                           __m128 vdst00 = _mm_mul_ps(vwl1, vsrc00);
-                           __m128 vdst01 = _mm_mul_ps(vwl0, vsrc01);
-                           __m128 vdst10 = _mm_mul_ps(vwl1, vsrc10);
-                           __m128 vdst11 = _mm_mul_ps(vwl0, vsrc11);
-
-                           __m128 vdst0 = _mm_add_ps(vdst00, vdst01);
-                           __m128 vdst1 = _mm_add_ps(vdst10, vdst11);
-
-                            __m128 vdst = _mm_add_ps(_mm_mul_ps(vhl1, vdst0), _mm_mul_ps(vhl0, vdst1));
-
-                           _mm_storeu_ps(pdst + i*block_size/2, vdst);
-                        }
+                __m128 vwl0 = _mm_set1_ps(w_lambda0);
+                __m128 vwl1 = _mm_set1_ps(w_lambda1);
+                __m128 vhl0 = _mm_set1_ps(h_lambda0);
+                __m128 vhl1 = _mm_set1_ps(h_lambda1);
+                for (int i = 0; i < block_size/4; i++) {
+                    __m128 vsrc00 = _mm_loadu_ps(psrc00 + i*block_size/2);
+                    __m128 vsrc01 = _mm_loadu_ps(psrc01 + i*block_size/2);
+                    __m128 vsrc10 = _mm_loadu_ps(psrc10 + i*block_size/2);
+                    __m128 vsrc11 = _mm_loadu_ps(psrc11 + i*block_size/2);
+
+                   __m128 vdst00 = _mm_mul_ps(vwl1, vsrc00);
+                   __m128 vdst01 = _mm_mul_ps(vwl0, vsrc01);
+                   __m128 vdst10 = _mm_mul_ps(vwl1, vsrc10);
+                   __m128 vdst11 = _mm_mul_ps(vwl0, vsrc11);
+
+                   __m128 vdst0 = _mm_add_ps(vdst00, vdst01);
+                   __m128 vdst1 = _mm_add_ps(vdst10, vdst11);
+
+                    __m128 vdst = _mm_add_ps(_mm_mul_ps(vhl1, vdst0), _mm_mul_ps(vhl0, vdst1));
+
+                   _mm_storeu_ps(pdst + i*block_size/2, vdst);
+                }
 #else
-                        for (int c = 0; c < block_size; ++c) {
-                            pdst[c] = h_lambda1 * (w_lambda1 * psrc00[c] + w_lambda0 * psrc01[c]) +
-                                      h_lambda0 * (w_lambda1 * psrc10[c] + w_lambda0 * psrc11[c]);
-                        }
-#endif
-                    }
+                for (int c = 0; c < block_size; ++c) {
+                    pdst[c] = h_lambda1 * (w_lambda1 * psrc00[c] + w_lambda0 * psrc01[c]) +
+                              h_lambda0 * (w_lambda1 * psrc10[c] + w_lambda0 * psrc11[c]);
                 }
+#endif
             }
-        }
+        });
     }
 };
 
 REG_FACTORY_FOR(ImplFactory<InterpImpl>, Interp);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine
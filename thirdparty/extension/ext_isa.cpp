@@ -0,0 +1,162 @@
+/*
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "ext_isa.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define EXT_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace InferenceEngine {
+namespace Extensions {
+namespace Cpu {
+
+namespace {
+
+#if defined(EXT_X86)
+void cpuid(unsigned leaf, unsigned regs[4]) {
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, static_cast<int>(leaf), 0);
+    for (int i = 0; i < 4; i++)
+        regs[i] = static_cast<unsigned>(r[i]);
+#else
+    __cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Register states the OS saves on context switches
+uint64_t xgetbv0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned eax = 0, edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+#endif
+
+struct CpuFeatures {
+    bool sse42 = false;
+    bool avx2 = false;
+    bool avx512f = false;
+
+    CpuFeatures() {
+#if defined(EXT_X86)
+        unsigned regs[4];
+        cpuid(0, regs);
+        const unsigned max_leaf = regs[0];
+        if (max_leaf < 1)
+            return;
+
+        cpuid(1, regs);
+        const bool fma = (regs[2] >> 12) & 1;
+        sse42 = (regs[2] >> 20) & 1;
+        const bool osxsave = (regs[2] >> 27) & 1;
+        const bool avx = (regs[2] >> 28) & 1;
+        if (max_leaf < 7 || !osxsave || !avx)
+            return;
+
+        // AVX needs the XMM and YMM states, AVX-512 the opmask and ZMM states as well
+        const uint64_t xcr0 = xgetbv0();
+        const bool os_avx = (xcr0 & 0x6) == 0x6;
+        const bool os_avx512 = (xcr0 & 0xe6) == 0xe6;
+
+        cpuid(7, regs);
+        avx2 = os_avx && fma && ((regs[1] >> 5) & 1);
+        avx512f = avx2 && os_avx512 && ((regs[1] >> 16) & 1);
+#endif
+    }
+};
+
+const CpuIsa isas[] = {CpuIsa::ANY, CpuIsa::SSE42, CpuIsa::AVX2, CpuIsa::AVX512F};
+
+CpuIsa selectCpuIsa() {
+#if defined(ENABLE_CPU_DISPATCH)
+    CpuIsa isa = CpuIsa::ANY;
+    for (CpuIsa level : isas) {
+        if (mayiuse(level))
+            isa = level;
+    }
+
+    const char *requested = std::getenv("CPU_EXTENSION_ISA");
+    if (requested != nullptr) {
+        for (CpuIsa level : isas) {
+            if (std::strcmp(requested, getCpuIsaName(level)) == 0 && level < isa)
+                isa = level;
+        }
+    }
+    return isa;
+#elif defined(HAVE_AVX512F)
+    return CpuIsa::AVX512F;
+#elif defined(HAVE_AVX2)
+    return CpuIsa::AVX2;
+#elif defined(HAVE_SSE)
+    return CpuIsa::SSE42;
+#else
+    return CpuIsa::ANY;
+#endif
+}
+
+}  // namespace
+
+bool mayiuse(CpuIsa isa) {
+    static const CpuFeatures features;
+    switch (isa) {
+    case CpuIsa::ANY:
+        return true;
+    case CpuIsa::SSE42:
+        return features.sse42;
+    case CpuIsa::AVX2:
+        return features.avx2;
+    case CpuIsa::AVX512F:
+        return features.avx512f;
+    }
+    return false;
+}
+
+CpuIsa getCpuIsa() {
+    static const CpuIsa isa = selectCpuIsa();
+    return isa;
+}
+
+const char *getCpuIsaName(CpuIsa isa) {
+    switch (isa) {
+    case CpuIsa::ANY:
+        return "any";
+    case CpuIsa::SSE42:
+        return "sse42";
+    case CpuIsa::AVX2:
+        return "avx2";
+    case CpuIsa::AVX512F:
+        return "avx512f";
+    }
+    return "unknown";
+}
+
+}  // namespace Cpu
+}  // namespace Extensions
+}  // namespace InferenceEngine
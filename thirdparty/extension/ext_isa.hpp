@@ -0,0 +1,66 @@
+/*
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+
+// Each build of the layers for an ISA level has its own namespace, so that the builds do not share symbols.
+// Inline functions and templates compiled with the flags of a level belong in it as well: the linker keeps one
+// copy of an inline function, which could otherwise be the build of a level the CPU does not support.
+#if defined(EXT_ISA)
+#define EXT_ISA_CONCAT_(a, b) a##b
+#define EXT_ISA_CONCAT(a, b) EXT_ISA_CONCAT_(a, b)
+#define EXT_ISA_NAMESPACE EXT_ISA_CONCAT(isa_, EXT_ISA)
+#else
+#define EXT_ISA_NAMESPACE native
+#endif
+
+namespace InferenceEngine {
+namespace Extensions {
+namespace Cpu {
+
+/**
+ * @brief Instruction set levels the layers are built for, from the lowest to the highest.
+ */
+enum class CpuIsa {
+    ANY,
+    SSE42,
+    AVX2,
+    AVX512F
+};
+
+/**
+ * @brief Whether the CPU and the operating system support the given level.
+ */
+bool mayiuse(CpuIsa isa);
+
+/**
+ * @brief Level the layers run with, selected once when the library is loaded.
+ *
+ * When the library is built with ENABLE_CPU_DISPATCH (the default) it holds the layers built for every level,
+ * and the highest level the CPU supports is selected. The CPU_EXTENSION_ISA environment variable ("any", "sse42",
+ * "avx2" or "avx512f") lowers it, e.g. to compare the levels on one machine; higher levels than the CPU supports
+ * are ignored. Otherwise it is the level the library is built for.
+ */
+CpuIsa getCpuIsa();
+
+/**
+ * @brief Lowercase name of the level, as accepted by CPU_EXTENSION_ISA.
+ */
+const char *getCpuIsaName(CpuIsa isa);
+
+}  // namespace Cpu
+}  // namespace Extensions
+}  // namespace InferenceEngine
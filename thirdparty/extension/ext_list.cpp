@@ -36,6 +36,30 @@ void CpuExtensions::AddExt(std::string name, ext_factory factory) {
     GetExtensionsHolder()->list[name] = factory;
 }
 
+StatusCode CpuExtensions::getPrimitiveTypes(char**& types, unsigned int& size, ResponseDesc* resp) noexcept {
+    auto& factories = CpuExtensions::GetExtensionsHolder()->list;
+    types = new char *[factories.size()];
+    size_t count = 0;
+    for (auto it = factories.begin(); it != factories.end(); it++, count ++) {
+        types[count] = new char[it->first.size() + 1];
+        std::copy(it->first.begin(), it->first.end(), types[count]);
+        types[count][it->first.size() ] = '\0';
+    }
+    return OK;
+}
+
+StatusCode CpuExtensions::getFactoryFor(ILayerImplFactory *&factory, const CNNLayer *cnnLayer,
+                                        ResponseDesc *resp) noexcept {
+    auto& factories = CpuExtensions::GetExtensionsHolder()->list;
+    if (factories.find(cnnLayer->type) == factories.end()) {
+        std::string errorMsg = std::string("Factory for ") + cnnLayer->type + " wasn't found!";
+        errorMsg.copy(resp->msg, sizeof(resp->msg) - 1);
+        return NOT_FOUND;
+    }
+    factory = factories[cnnLayer->type](cnnLayer);
+    return OK;
+}
+
 void CpuExtensions::GetVersion(const Version*& versionInfo) const noexcept {
     static Version ExtensionDescription = {
             { 1, 0 },    // extension API version
@@ -18,6 +18,8 @@
 
 #include <ie_iextension.h>
 
+#include "ext_isa.hpp"
+
 #include <string>
 #include <map>
 #include <memory>
@@ -36,27 +38,8 @@ struct ExtensionsHolder {
 
 class INFERENCE_ENGINE_API_CLASS(CpuExtensions) : public IExtension {
 public:
-    StatusCode getPrimitiveTypes(char**& types, unsigned int& size, ResponseDesc* resp) noexcept override {
-        auto& factories = CpuExtensions::GetExtensionsHolder()->list;
-        types = new char *[factories.size()];
-        size_t count = 0;
-        for (auto it = factories.begin(); it != factories.end(); it++, count ++) {
-            types[count] = new char[it->first.size() + 1];
-            std::copy(it->first.begin(), it->first.end(), types[count]);
-            types[count][it->first.size() ] = '\0';
-        }
-        return OK;
-    };
-    StatusCode getFactoryFor(ILayerImplFactory *&factory, const CNNLayer *cnnLayer, ResponseDesc *resp) noexcept override {
-        auto& factories = CpuExtensions::GetExtensionsHolder()->list;
-        if (factories.find(cnnLayer->type) == factories.end()) {
-            std::string errorMsg = std::string("Factory for ") + cnnLayer->type + " wasn't found!";
-            errorMsg.copy(resp->msg, sizeof(resp->msg) - 1);
-            return NOT_FOUND;
-        }
-        factory = factories[cnnLayer->type](cnnLayer);
-        return OK;
-    }
+    StatusCode getPrimitiveTypes(char**& types, unsigned int& size, ResponseDesc* resp) noexcept override;
+    StatusCode getFactoryFor(ILayerImplFactory *&factory, const CNNLayer *cnnLayer, ResponseDesc *resp) noexcept override;
     void GetVersion(const InferenceEngine::Version *& versionInfo) const noexcept override;
     void SetLogCallback(InferenceEngine::IErrorListener &listener) noexcept override {};
     void Unload() noexcept override {};
@@ -66,17 +49,27 @@ public:
     static std::shared_ptr<ExtensionsHolder> GetExtensionsHolder();
 };
 
+// Registers the factory of a layer built for the given ISA level, if the layers run with that level
 template<typename Ext> class ExtRegisterBase {
 public:
-    explicit ExtRegisterBase(const std::string& type) {
+    explicit ExtRegisterBase(const std::string& type, CpuIsa isa = getCpuIsa()) {
+        if (isa != getCpuIsa())
+            return;
         CpuExtensions::AddExt(type,
             [](const CNNLayer *layer) -> InferenceEngine::ILayerImplFactory* {
                 return new Ext(layer);
             });
     }
 };
+// With runtime dispatch the layers are built once per ISA level, with EXT_ISA set to the level,
+// and only the build of the selected level registers its factories
+#if defined(EXT_ISA)
+#define REG_FACTORY_FOR(__prim, __type) \
+static ExtRegisterBase<__prim> __reg__##__type(#__type, CpuIsa::EXT_ISA)
+#else
 #define REG_FACTORY_FOR(__prim, __type) \
 static ExtRegisterBase<__prim> __reg__##__type(#__type)
+#endif
 
 }  // namespace Cpu
 }  // namespace Extensions
@@ -16,7 +16,10 @@
 
 #include "ext_list.hpp"
 #include "ext_base.hpp"
+#include "parallel.h"
+#include "simd.h"
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <vector>
@@ -24,6 +27,73 @@
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
+
+// Channels of the blocked layout, one vector (two SSE vectors) per pixel
+#if defined(HAVE_AVX512F)
+const int mvn_block = 16;
+#else
+const int mvn_block = 8;
+#endif
+
+// Floats of a planar channel loaded per step, 4 vectors to hide the latency of the additions
+const int mvn_lanes = 4 * vec_len;
+
+// Steps summed in float before adding to the double sums
+const size_t mvn_flush = 64;
+
+// Adds the sums of (x - shift) and (x - shift)^2 over count groups of L floats to sum and sum2, lane by lane.
+// Shifting by a value close to the mean keeps sum2 / n - (sum / n)^2 accurate, so one pass gives both moments.
+template <int L>
+void mvn_accumulate(const float* src, size_t count, const float* shift, double* sum, double* sum2) {
+    const int nvec = L / vec_len;
+    vec_t vshift[nvec];
+    for (int v = 0; v < nvec; v++)
+        vshift[v] = vec_load(shift + v*vec_len);
+
+    for (size_t start = 0; start < count; start += mvn_flush) {
+        const size_t end = std::min(count, start + mvn_flush);
+        vec_t vsum[nvec], vsum2[nvec];
+        for (int v = 0; v < nvec; v++) {
+            vsum[v] = vec_zero();
+            vsum2[v] = vec_zero();
+        }
+        for (size_t i = start; i < end; i++) {
+            for (int v = 0; v < nvec; v++) {
+                vec_t d = vec_sub(vec_load(src + i*L + v*vec_len), vshift[v]);
+                vsum[v] = vec_add(vsum[v], d);
+                vsum2[v] = vec_fmadd(d, d, vsum2[v]);
+            }
+        }
+
+        float lane_sum[L], lane_sum2[L];
+        for (int v = 0; v < nvec; v++) {
+            vec_store(lane_sum + v*vec_len, vsum[v]);
+            vec_store(lane_sum2 + v*vec_len, vsum2[v]);
+        }
+        for (int l = 0; l < L; l++) {
+            sum[l] += lane_sum[l];
+            sum2[l] += lane_sum2[l];
+        }
+    }
+}
+
+// dst = (src - mean) * scale over count groups of L floats, lane by lane
+template <int L>
+void mvn_normalize(const float* src, float* dst, size_t count, const float* mean, const float* scale) {
+    const int nvec = L / vec_len;
+    vec_t vmean[nvec], vscale[nvec];
+    for (int v = 0; v < nvec; v++) {
+        vmean[v] = vec_load(mean + v*vec_len);
+        vscale[v] = vec_load(scale + v*vec_len);
+    }
+    for (size_t i = 0; i < count; i++) {
+        for (int v = 0; v < nvec; v++) {
+            vec_t x = vec_load(src + i*L + v*vec_len);
+            vec_store(dst + i*L + v*vec_len, vec_mul(vec_sub(x, vmean[v]), vscale[v]));
+        }
+    }
+}
 
 class MVNImpl: public ExtLayerBase {
 public:
@@ -37,6 +107,14 @@ public:
             eps = cnnLayer.GetParamAsFloat("eps");
 
             addConfig({{ConfLayout::PLN, false, 0}}, {{ConfLayout::PLN, false, 0}});
+            if (cnnLayer.insData[0].lock()->dims.size() == 4) {
+#if defined(HAVE_AVX512F)
+                auto blk_layout = ConfLayout::BLK16;
+#else
+                auto blk_layout = ConfLayout::BLK8;
+#endif
+                addConfig({{blk_layout, false, 0}}, {{blk_layout, false, 0}});
+            }
         } catch (InferenceEngine::details::InferenceEngineException &ex) {
             errorMsg = ex.what();
         }
@@ -44,101 +122,128 @@ public:
 
     StatusCode execute(std::vector<Blob::Ptr>& inputs, std::vector<Blob::Ptr>& outputs,
                        ResponseDesc *resp) noexcept override {
-        float* src_data = inputs[0]->buffer();
+        const float* src_data = inputs[0]->buffer();
         float* dst_data = outputs[0]->buffer();
 
         SizeVector dims = inputs[0]->getTensorDesc().getDims();
+        SizeVector blk_dims = inputs[0]->getTensorDesc().getBlockingDesc().getBlockDims();
+        const bool blocked = blk_dims.size() == 5;
+        if (blocked && blk_dims[4] != mvn_block) {
+            if (resp) {
+                std::string errorMsg = "Unsupported channel block size!";
+                errorMsg.copy(resp->msg, sizeof(resp->msg) - 1);
+            }
+            return GENERAL_ERROR;
+        }
 
         int N = static_cast<int>((dims.size() > 0) ? dims[0] : 1);
         int C = static_cast<int>((dims.size() > 1) ? dims[1] : 1);
         int H = static_cast<int>((dims.size() > 2) ? dims[2] : 1);
         int W = static_cast<int>((dims.size() > 3) ? dims[3] : 1);
 
+        // Channels in memory: the planar ones or whole blocks, the padding of the last block included
+        const int blk = blocked ? mvn_block : 1;
+        const int CB = (C + blk - 1) / blk;
+        const int CP = CB * blk;
+        const size_t HW = static_cast<size_t>(H) * W;
+
+        const int nthr = parallelThreads(static_cast<size_t>(N)*C*H*W);
+
+        // Statistics of the whole sample are shifted by its first value, those of a channel by its own first value
+        std::vector<float> shift(static_cast<size_t>(N) * CP, 0.f);
         for (int b = 0; b < N; b++) {
-            // Calculate mean value
-            if (across_channels) {
-                double mean = 0;
-                #pragma omp parallel for reduction(+ : mean) schedule(static)
-                for (int c = 0; c < C; c++) {
-                    for (int h = 0; h < H; h++) {
-                        for (int w = 0; w < W; w++) {
-                            mean += src_data[b*C*H*W + c*H*W + h*W + w];
-                        }
-                    }
+            const float* src_b = src_data + static_cast<size_t>(b) * CP * HW;
+            for (int c = 0; c < C; c++) {
+                if (across_channels)
+                    shift[b*CP + c] = src_b[0];
+                else
+                    shift[b*CP + c] = blocked ? src_b[(c / blk) * HW * blk + c % blk] : src_b[c * HW];
+            }
+        }
+
+        // One pass over the source for the sums of every channel
+        std::vector<double> sum(static_cast<size_t>(N) * CP, 0.0);
+        std::vector<double> sum2(static_cast<size_t>(N) * CP, 0.0);
+        if (blocked) {
+            parallel_for2d(nthr, N, CB, [&](int b, int cb) {
+                const size_t offset = (static_cast<size_t>(b) * CB + cb) * blk;
+                mvn_accumulate<mvn_block>(src_data + offset * HW, HW, &shift[offset], &sum[offset], &sum2[offset]);
+            });
+        } else {
+            parallel_for2d(nthr, N, C, [&](int b, int c) {
+                const size_t offset = static_cast<size_t>(b) * C + c;
+                const float* src = src_data + offset * HW;
+                const float s = shift[offset];
+                const size_t count = HW / mvn_lanes;
+
+                float lane_shift[mvn_lanes];
+                double lane_sum[mvn_lanes] = {0}, lane_sum2[mvn_lanes] = {0};
+                std::fill(lane_shift, lane_shift + mvn_lanes, s);
+                mvn_accumulate<mvn_lanes>(src, count, lane_shift, lane_sum, lane_sum2);
+
+                double chan_sum = 0, chan_sum2 = 0;
+                for (int l = 0; l < mvn_lanes; l++) {
+                    chan_sum += lane_sum[l];
+                    chan_sum2 += lane_sum2[l];
                 }
-                mean /= C*H*W;
-                #pragma omp parallel for schedule(static)
-                for (int c = 0; c < C; c++) {
-                    for (int h = 0; h < H; h++) {
-                        for (int w = 0; w < W; w++) {
-                            dst_data[b*C*H*W + c*H*W + h*W + w] = src_data[b*C*H*W + c*H*W + h*W + w] - mean;
-                        }
-                    }
+                for (size_t i = count * mvn_lanes; i < HW; i++) {
+                    double d = src[i] - s;
+                    chan_sum += d;
+                    chan_sum2 += d * d;
                 }
-            } else {
-                #pragma omp parallel for schedule(static)
+                sum[offset] = chan_sum;
+                sum2[offset] = chan_sum2;
+            });
+        }
+
+        // Per channel mean and scale, padding channels are written as zeros
+        std::vector<float> mean(static_cast<size_t>(N) * CP, 0.f);
+        std::vector<float> scale(static_cast<size_t>(N) * CP, 0.f);
+        auto set_stats = [&](int b, int c_begin, int c_end, double shift_value, double group_sum, double group_sum2,
+                             double group_size) {
+            double group_mean = group_sum / group_size;
+            double variance = std::max(group_sum2 / group_size - group_mean * group_mean, 0.0);
+            float group_scale = normalize_variance ? static_cast<float>(1.0 / (std::sqrt(variance) + eps)) : 1.f;
+            for (int c = c_begin; c < c_end; c++) {
+                mean[b*CP + c] = static_cast<float>(shift_value + group_mean);
+                scale[b*CP + c] = group_scale;
+            }
+        };
+        for (int b = 0; b < N; b++) {
+            if (across_channels) {
+                double sample_sum = 0, sample_sum2 = 0;
                 for (int c = 0; c < C; c++) {
-                    double mean = 0;
-                    for (int h = 0; h < H; h++) {
-                        for (int w = 0; w < W; w++) {
-                            mean += src_data[b*C*H*W + c*H*W + h*W + w];
-                        }
-                    }
-                    mean /= H*W;
-
-                    for (int h = 0; h < H; h++) {
-                        for (int w = 0; w < W; w++) {
-                            dst_data[b*C*H*W + c*H*W + h*W + w] = src_data[b*C*H*W + c*H*W + h*W + w] - mean;
-                        }
-                    }
+                    sample_sum += sum[b*CP + c];
+                    sample_sum2 += sum2[b*CP + c];
                 }
+                set_stats(b, 0, C, shift[b*CP], sample_sum, sample_sum2, static_cast<double>(C) * HW);
+            } else {
+                for (int c = 0; c < C; c++)
+                    set_stats(b, c, c + 1, shift[b*CP + c], sum[b*CP + c], sum2[b*CP + c], static_cast<double>(HW));
             }
         }
 
-        if (normalize_variance) {
-            for (int b = 0; b < N; b++) {
-                // Calculate variances value
-                if (across_channels) {
-                    double variance = 0;
-                    #pragma omp parallel for reduction(+ : variance) schedule(static)
-                    for (int c = 0; c < C; c++) {
-                        for (int h = 0; h < H; h++) {
-                            for (int w = 0; w < W; w++) {
-                                variance += std::pow(dst_data[b*C*H*W + c*H*W + h*W + w], 2);
-                            }
-                        }
-                    }
-                    variance /= C*H*W;
-                    variance = std::pow(variance, 0.5f);
-                    variance += eps;
-                    #pragma omp parallel for schedule(static)
-                    for (int c = 0; c < C; c++) {
-                        for (int h = 0; h < H; h++) {
-                            for (int w = 0; w < W; w++) {
-                                dst_data[b*C*H*W + c*H*W + h*W + w] /= variance;
-                            }
-                        }
-                    }
-                } else {
-                    #pragma omp parallel for schedule(static)
-                    for (int c = 0; c < C; c++) {
-                        double variance = 0;
-                        for (int h = 0; h < H; h++) {
-                            for (int w = 0; w < W; w++) {
-                                variance += std::pow(dst_data[b*C*H*W + c*H*W + h*W + w], 2);
-                            }
-                        }
-                        variance /= H*W;
-                        variance = std::pow(variance, 0.5f);
-                        variance += eps;
-                        for (int h = 0; h < H; h++) {
-                            for (int w = 0; w < W; w++) {
-                                dst_data[b*C*H*W + c*H*W + h*W + w] /= variance;
-                            }
-                        }
-                    }
-                }
-            }
+        // Second pass subtracts the mean and scales by the inverse deviation at once
+        if (blocked) {
+            parallel_for2d(nthr, N, CB, [&](int b, int cb) {
+                const size_t offset = (static_cast<size_t>(b) * CB + cb) * blk;
+                mvn_normalize<mvn_block>(src_data + offset * HW, dst_data + offset * HW, HW,
+                                         &mean[offset], &scale[offset]);
+            });
+        } else {
+            parallel_for2d(nthr, N, C, [&](int b, int c) {
+                const size_t offset = static_cast<size_t>(b) * C + c;
+                const float* src = src_data + offset * HW;
+                float* dst = dst_data + offset * HW;
+                const size_t count = HW / mvn_lanes;
+
+                float lane_mean[mvn_lanes], lane_scale[mvn_lanes];
+                std::fill(lane_mean, lane_mean + mvn_lanes, mean[offset]);
+                std::fill(lane_scale, lane_scale + mvn_lanes, scale[offset]);
+                mvn_normalize<mvn_lanes>(src, dst, count, lane_mean, lane_scale);
+                for (size_t i = count * mvn_lanes; i < HW; i++)
+                    dst[i] = (src[i] - mean[offset]) * scale[offset];
+            });
         }
         return OK;
     }
@@ -151,6 +256,7 @@ private:
 
 REG_FACTORY_FOR(ImplFactory<MVNImpl>, MVN);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine
@@ -26,6 +26,7 @@
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
 
 class NormalizeImpl: public ExtLayerBase {
 public:
@@ -242,6 +243,7 @@ public:
 
 REG_FACTORY_FOR(NormalizeFactory, Normalize);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine
@@ -0,0 +1,112 @@
+/*
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "ext_parallel.hpp"
+#include "parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace InferenceEngine {
+namespace Extensions {
+namespace Cpu {
+
+namespace {
+
+class OmpParallelBackend : public ParallelBackend {
+public:
+    int getMaxThreads() const override {
+#ifdef _OPENMP
+        return omp_get_max_threads();
+#else
+        return 1;
+#endif
+    }
+
+    void run(int nthr, const std::function<void(int, int)>& body) override {
+#ifdef _OPENMP
+        #pragma omp parallel num_threads(nthr)
+        body(omp_get_thread_num(), omp_get_num_threads());
+#else
+        body(0, 1);
+#endif
+    }
+};
+
+class SerialParallelBackend : public ParallelBackend {
+public:
+    int getMaxThreads() const override {
+        return 1;
+    }
+
+    void run(int nthr, const std::function<void(int, int)>& body) override {
+        body(0, 1);
+    }
+};
+
+ParallelBackend::Ptr& userBackend() {
+    static ParallelBackend::Ptr backend;
+    return backend;
+}
+
+std::atomic<int> threadBudget(0);
+
+}  // namespace
+
+ParallelBackend::Ptr makeOmpParallelBackend() {
+    return std::make_shared<OmpParallelBackend>();
+}
+
+ParallelBackend::Ptr makeSerialParallelBackend() {
+    return std::make_shared<SerialParallelBackend>();
+}
+
+void setParallelBackend(ParallelBackend::Ptr backend) {
+    std::atomic_store(&userBackend(), backend);
+}
+
+ParallelBackend::Ptr getParallelBackend() {
+    static const ParallelBackend::Ptr defaultBackend = makeOmpParallelBackend();
+    ParallelBackend::Ptr backend = std::atomic_load(&userBackend());
+    return backend ? backend : defaultBackend;
+}
+
+void setParallelThreadBudget(int threads) {
+    threadBudget = std::max(threads, 0);
+}
+
+int getParallelThreadBudget() {
+    return threadBudget;
+}
+
+int parallel_get_num_threads(size_t work, int budget) {
+    int nthr = getParallelBackend()->getMaxThreads();
+    if (budget <= 0)
+        budget = getParallelThreadBudget();
+    if (budget > 0)
+        nthr = std::min(nthr, budget);
+    const size_t by_work = work / PARALLEL_MIN_WORK_PER_THREAD;
+    return static_cast<int>(std::max<size_t>(1, std::min<size_t>(nthr, by_work)));
+}
+
+}  // namespace Cpu
+}  // namespace Extensions
+}  // namespace InferenceEngine
@@ -0,0 +1,81 @@
+/*
+// Copyright (c) 2017-2018 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+
+#include <functional>
+#include <memory>
+
+namespace InferenceEngine {
+namespace Extensions {
+namespace Cpu {
+
+/**
+ * @brief Runs the parallel loops of the extension layers.
+ *
+ * All the layers share one backend. The default one runs the loops on the OpenMP runtime of the
+ * process, i.e. on the same threads as the CPU plugin, or serially if the library is built without
+ * OpenMP. An application with its own thread pool can plug it in instead, so that the layers do not
+ * start a second set of threads competing with the pool for the cores.
+ */
+class ParallelBackend {
+public:
+    using Ptr = std::shared_ptr<ParallelBackend>;
+
+    virtual ~ParallelBackend() = default;
+
+    /**
+     * @brief Number of threads a loop can run on.
+     */
+    virtual int getMaxThreads() const = 0;
+
+    /**
+     * @brief Calls body(ithr, nthr) for each ithr in [0, nthr) and returns when all the calls have returned.
+     * The backend may run the loop on fewer threads than asked for, body then gets the actual number as nthr.
+     */
+    virtual void run(int nthr, const std::function<void(int, int)>& body) = 0;
+};
+
+/**
+ * @brief Backend running the loops on the OpenMP runtime, or serially without OpenMP.
+ */
+ParallelBackend::Ptr makeOmpParallelBackend();
+
+/**
+ * @brief Backend running the loops on the calling thread.
+ */
+ParallelBackend::Ptr makeSerialParallelBackend();
+
+/**
+ * @brief Sets the backend of all the layers, nullptr restores the default one.
+ * Layers executing when the backend is changed finish their loops on the previous one.
+ */
+void setParallelBackend(ParallelBackend::Ptr backend);
+
+ParallelBackend::Ptr getParallelBackend();
+
+/**
+ * @brief Sets the number of threads a layer runs its loops on, 0 (the default) for all the threads of
+ * the backend. Layers with a "parallel_threads" parameter in the IR use it instead.
+ * Capping the layers keeps concurrent infer requests from oversubscribing the cores.
+ */
+void setParallelThreadBudget(int threads);
+
+int getParallelThreadBudget();
+
+}  // namespace Cpu
+}  // namespace Extensions
+}  // namespace InferenceEngine
@@ -24,6 +24,7 @@
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
 
 class PowerFileImpl: public ExtLayerBase {
 public:
@@ -71,6 +72,7 @@ private:
 
 REG_FACTORY_FOR(ImplFactory<PowerFileImpl>, PowerFile);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine
@@ -17,13 +17,16 @@
 #include "ext_list.hpp"
 #include "ext_base.hpp"
 
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <cmath>
+#include <mutex>
 
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
 
 class PriorBoxImpl: public ExtLayerBase {
 public:
@@ -107,9 +110,27 @@ public:
             }
             return GENERAL_ERROR;
         }
-        auto& dataMemPtr = inputs[0];
-        auto& imageMemPtr = inputs[1];
-        auto& dstMemPtr = outputs[0];
+
+        // The priors only depend on the shapes, which stay the same between the requests
+        SizeVector shapes = inputs[0]->getTensorDesc().getDims();
+        for (const Blob::Ptr& blob : {inputs[1], outputs[0]}) {
+            const SizeVector& dims = blob->getTensorDesc().getDims();
+            shapes.insert(shapes.end(), dims.begin(), dims.end());
+        }
+
+        std::lock_guard<std::mutex> lock(_cache_mutex);
+        if (_priors.empty() || shapes != _cached_shapes) {
+            _priors.assign(outputs[0]->size(), 0.0f);
+            calculatePriors(inputs[0], inputs[1], outputs[0], _priors.data());
+            _cached_shapes = shapes;
+        }
+        std::copy(_priors.begin(), _priors.end(), outputs[0]->buffer().as<float *>());
+        return OK;
+    }
+
+private:
+    void calculatePriors(const Blob::Ptr& dataMemPtr, const Blob::Ptr& imageMemPtr, const Blob::Ptr& dstMemPtr,
+                         float* dst_data) {
         SizeVector _data_dims = dataMemPtr->getTensorDesc().getDims();
         SizeVector _image_dims = imageMemPtr->getTensorDesc().getDims();
         const int W = _data_dims[3];
@@ -131,8 +152,6 @@ public:
             step_y = _step;
         }
 
-        float* dst_data = dstMemPtr->buffer();
-
         int dim = H * W * _num_priors * 4;
         int idx = 0;
         float center_x = 0.0f;
@@ -216,10 +235,8 @@ public:
                 }
             }
         }
-        return OK;
     }
 
-private:
     float _offset = 0;
     float _step = 0;
     std::vector<float> _min_sizes;
@@ -232,10 +249,15 @@ private:
     std::vector<float> _variance;
 
     int _num_priors = 0;
+
+    std::mutex _cache_mutex;
+    SizeVector _cached_shapes;
+    std::vector<float> _priors;
 };
 
 REG_FACTORY_FOR(ImplFactory<PriorBoxImpl>, PriorBox);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine
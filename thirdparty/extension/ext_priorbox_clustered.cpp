@@ -17,11 +17,13 @@
 #include "ext_list.hpp"
 #include "ext_base.hpp"
 #include <algorithm>
+#include <mutex>
 #include <vector>
 
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
 
 class PriorBoxClusteredImpl: public ExtLayerBase {
 public:
@@ -40,6 +42,8 @@ public:
             step_h_ = cnnLayer.GetParamAsFloat("step_h", 0);
             step_w_ = cnnLayer.GetParamAsFloat("step_w", 0);
             offset_ = cnnLayer.GetParamAsFloat("offset");
+            if (variance_.empty())
+                variance_.push_back(0.1f);
 
             addConfig({{ConfLayout::PLN, true}, {ConfLayout::PLN, true}}, {{ConfLayout::PLN, true}});
         } catch (InferenceEngine::details::InferenceEngineException &ex) {
@@ -49,12 +53,28 @@ public:
 
     StatusCode execute(std::vector<Blob::Ptr>& inputs, std::vector<Blob::Ptr>& outputs,
                        ResponseDesc *resp) noexcept override {
-        int num_priors_ = widths_.size();
+        // The priors only depend on the shapes, which stay the same between the requests
+        SizeVector shapes = inputs[0]->getTensorDesc().getDims();
+        for (const Blob::Ptr& blob : {inputs[1], outputs[0]}) {
+            const SizeVector& dims = blob->getTensorDesc().getDims();
+            shapes.insert(shapes.end(), dims.begin(), dims.end());
+        }
 
-        if (variance_.empty())
-            variance_.push_back(0.1);
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        if (priors_.empty() || shapes != cached_shapes_) {
+            priors_.assign(outputs[0]->size(), 0.0f);
+            calculatePriors(inputs, outputs, priors_.data());
+            cached_shapes_ = shapes;
+        }
+        std::copy(priors_.begin(), priors_.end(), outputs[0]->buffer().as<float *>());
+        return OK;
+    }
+
+private:
+    void calculatePriors(const std::vector<Blob::Ptr>& inputs, const std::vector<Blob::Ptr>& outputs,
+                         float* top_data_0) {
+        int num_priors_ = widths_.size();
 
-        // Execute
         const int layer_width = inputs[0]->getTensorDesc().getDims()[3];
         const int layer_height = inputs[0]->getTensorDesc().getDims()[2];
 
@@ -64,7 +84,6 @@ public:
         float step_w = step_w_ == 0 ? step_ : step_w_;
         float step_h = step_h_ == 0 ? step_ : step_h_;
 
-        auto *top_data_0 = outputs[0]->buffer().as<float *>();
         float *top_data_1 = top_data_0 + outputs[0]->getTensorDesc().getDims()[2];
         int var_size = variance_.size();
 
@@ -101,10 +120,8 @@ public:
                 }
             }
         }
-        return OK;
     }
 
-private:
     std::vector<float> widths_;
     std::vector<float> heights_;
     std::vector<float> variance_;
@@ -115,10 +132,15 @@ private:
     float step_h_;
     float step_w_;
     float offset_;
+
+    std::mutex cache_mutex_;
+    SizeVector cached_shapes_;
+    std::vector<float> priors_;
 };
 
 REG_FACTORY_FOR(ImplFactory<PriorBoxClusteredImpl>, PriorBoxClustered);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine
@@ -16,6 +16,7 @@
 
 #include "ext_list.hpp"
 #include "ext_base.hpp"
+#include "parallel.h"
 
 #include <cmath>
 #include <string>
@@ -27,6 +28,7 @@
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
 
 static
 void generate_anchors(int base_size, float* ratios,
@@ -83,7 +85,7 @@ void enumerate_proposals_cpu(const float* bottom4d, const float* d_anchor4d, con
                              const int bottom_W, const float img_H, const float img_W,
                              const float min_box_H, const float min_box_W, const int feat_stride,
                              const float box_coordinate_scale, const float box_size_scale,
-                             float coordinates_offset, bool initial_clip, bool swap_xy) {
+                             float coordinates_offset, bool initial_clip, bool swap_xy, int nthr) {
     const int bottom_area = bottom_H * bottom_W;
 
     const float* p_anchors_wm = anchors + 0 * num_anchors;
@@ -91,92 +93,84 @@ void enumerate_proposals_cpu(const float* bottom4d, const float* d_anchor4d, con
     const float* p_anchors_wp = anchors + 2 * num_anchors;
     const float* p_anchors_hp = anchors + 3 * num_anchors;
 
-#if _MSC_VER && !__INTEL_COMPILER
-    #pragma omp parallel for schedule(static)
-#else
-    #pragma omp parallel for collapse(2) schedule(static)
-#endif
-    for (int h = 0; h < bottom_H; ++h) {
-        for (int w = 0; w < bottom_W; ++w) {
-            const float x = (swap_xy ? h : w) * feat_stride;
-            const float y = (swap_xy ? w : h) * feat_stride;
-
-            const float* p_box   = d_anchor4d + h * bottom_W + w;
-            const float* p_score = bottom4d   + h * bottom_W + w;
-
-            float* p_proposal = proposals + (h * bottom_W + w) * num_anchors * 5;
-
-            for (int anchor = 0; anchor < num_anchors; ++anchor) {
-                const float dx = p_box[(anchor * 4 + 0) * bottom_area] / box_coordinate_scale;
-                const float dy = p_box[(anchor * 4 + 1) * bottom_area] / box_coordinate_scale;
-
-                const float d_log_w = p_box[(anchor * 4 + 2) * bottom_area] / box_size_scale;
-                const float d_log_h = p_box[(anchor * 4 + 3) * bottom_area] / box_size_scale;
-
-                const float score = p_score[anchor * bottom_area];
-
-                float x0 = x + p_anchors_wm[anchor];
-                float y0 = y + p_anchors_hm[anchor];
-                float x1 = x + p_anchors_wp[anchor];
-                float y1 = y + p_anchors_hp[anchor];
-
-                if (initial_clip) {
-                    // adjust new corner locations to be within the image region
-                    x0 = std::max<float>(0.0f, std::min<float>(x0, img_W));
-                    y0 = std::max<float>(0.0f, std::min<float>(y0, img_H));
-                    x1 = std::max<float>(0.0f, std::min<float>(x1, img_W));
-                    y1 = std::max<float>(0.0f, std::min<float>(y1, img_H));
-                }
-
-                // width & height of box
-                const float ww = x1 - x0 + coordinates_offset;
-                const float hh = y1 - y0 + coordinates_offset;
-                // center location of box
-                const float ctr_x = x0 + 0.5f * ww;
-                const float ctr_y = y0 + 0.5f * hh;
-
-                // new center location according to gradient (dx, dy)
-                const float pred_ctr_x = dx * ww + ctr_x;
-                const float pred_ctr_y = dy * hh + ctr_y;
-                // new width & height according to gradient d(log w), d(log h)
-                const float pred_w = std::exp(d_log_w) * ww;
-                const float pred_h = std::exp(d_log_h) * hh;
-
-                // update upper-left corner location
-                x0 = pred_ctr_x - 0.5f * pred_w;
-                y0 = pred_ctr_y - 0.5f * pred_h;
-                // update lower-right corner location
-                x1 = pred_ctr_x + 0.5f * pred_w;
-                y1 = pred_ctr_y + 0.5f * pred_h;
-
-                // adjust new corner locations to be within the image region,
-                x0 = std::max<float>(0.0f, std::min<float>(x0, img_W - coordinates_offset));
-                y0 = std::max<float>(0.0f, std::min<float>(y0, img_H - coordinates_offset));
-                x1 = std::max<float>(0.0f, std::min<float>(x1, img_W - coordinates_offset));
-                y1 = std::max<float>(0.0f, std::min<float>(y1, img_H - coordinates_offset));
-
-                // recompute new width & height
-                const float box_w = x1 - x0 + coordinates_offset;
-                const float box_h = y1 - y0 + coordinates_offset;
-
-                p_proposal[5*anchor + 0] = x0;
-                p_proposal[5*anchor + 1] = y0;
-                p_proposal[5*anchor + 2] = x1;
-                p_proposal[5*anchor + 3] = y1;
-                p_proposal[5*anchor + 4] = (min_box_W <= box_w) * (min_box_H <= box_h) * score;
+    parallel_for2d(nthr, bottom_H, bottom_W, [&](int h, int w) {
+        const float x = (swap_xy ? h : w) * feat_stride;
+        const float y = (swap_xy ? w : h) * feat_stride;
+
+        const float* p_box   = d_anchor4d + h * bottom_W + w;
+        const float* p_score = bottom4d   + h * bottom_W + w;
+
+        float* p_proposal = proposals + (h * bottom_W + w) * num_anchors * 5;
+
+        for (int anchor = 0; anchor < num_anchors; ++anchor) {
+            const float dx = p_box[(anchor * 4 + 0) * bottom_area] / box_coordinate_scale;
+            const float dy = p_box[(anchor * 4 + 1) * bottom_area] / box_coordinate_scale;
+
+            const float d_log_w = p_box[(anchor * 4 + 2) * bottom_area] / box_size_scale;
+            const float d_log_h = p_box[(anchor * 4 + 3) * bottom_area] / box_size_scale;
+
+            const float score = p_score[anchor * bottom_area];
+
+            float x0 = x + p_anchors_wm[anchor];
+            float y0 = y + p_anchors_hm[anchor];
+            float x1 = x + p_anchors_wp[anchor];
+            float y1 = y + p_anchors_hp[anchor];
+
+            if (initial_clip) {
+                // adjust new corner locations to be within the image region
+                x0 = std::max<float>(0.0f, std::min<float>(x0, img_W));
+                y0 = std::max<float>(0.0f, std::min<float>(y0, img_H));
+                x1 = std::max<float>(0.0f, std::min<float>(x1, img_W));
+                y1 = std::max<float>(0.0f, std::min<float>(y1, img_H));
             }
+
+            // width & height of box
+            const float ww = x1 - x0 + coordinates_offset;
+            const float hh = y1 - y0 + coordinates_offset;
+            // center location of box
+            const float ctr_x = x0 + 0.5f * ww;
+            const float ctr_y = y0 + 0.5f * hh;
+
+            // new center location according to gradient (dx, dy)
+            const float pred_ctr_x = dx * ww + ctr_x;
+            const float pred_ctr_y = dy * hh + ctr_y;
+            // new width & height according to gradient d(log w), d(log h)
+            const float pred_w = std::exp(d_log_w) * ww;
+            const float pred_h = std::exp(d_log_h) * hh;
+
+            // update upper-left corner location
+            x0 = pred_ctr_x - 0.5f * pred_w;
+            y0 = pred_ctr_y - 0.5f * pred_h;
+            // update lower-right corner location
+            x1 = pred_ctr_x + 0.5f * pred_w;
+            y1 = pred_ctr_y + 0.5f * pred_h;
+
+            // adjust new corner locations to be within the image region,
+            x0 = std::max<float>(0.0f, std::min<float>(x0, img_W - coordinates_offset));
+            y0 = std::max<float>(0.0f, std::min<float>(y0, img_H - coordinates_offset));
+            x1 = std::max<float>(0.0f, std::min<float>(x1, img_W - coordinates_offset));
+            y1 = std::max<float>(0.0f, std::min<float>(y1, img_H - coordinates_offset));
+
+            // recompute new width & height
+            const float box_w = x1 - x0 + coordinates_offset;
+            const float box_h = y1 - y0 + coordinates_offset;
+
+            p_proposal[5*anchor + 0] = x0;
+            p_proposal[5*anchor + 1] = y0;
+            p_proposal[5*anchor + 2] = x1;
+            p_proposal[5*anchor + 3] = y1;
+            p_proposal[5*anchor + 4] = (min_box_W <= box_w) * (min_box_H <= box_h) * score;
         }
-    }
+    });
 }
 
-static void unpack_boxes(const float* p_proposals, float* unpacked_boxes, int pre_nms_topn) {
-    #pragma omp parallel for schedule(static)
-    for (int i = 0; i < pre_nms_topn; i++) {
+static void unpack_boxes(const float* p_proposals, float* unpacked_boxes, int pre_nms_topn, int nthr) {
+    parallel_for(nthr, pre_nms_topn, [&](int i) {
         unpacked_boxes[0*pre_nms_topn + i] = p_proposals[5*i + 0];
         unpacked_boxes[1*pre_nms_topn + i] = p_proposals[5*i + 1];
         unpacked_boxes[2*pre_nms_topn + i] = p_proposals[5*i + 2];
         unpacked_boxes[3*pre_nms_topn + i] = p_proposals[5*i + 3];
-    }
+    });
 }
 
 static
@@ -307,14 +301,13 @@ static
 void retrieve_rois_cpu(const int num_rois, const int item_index,
                               const int num_proposals,
                               const float* proposals, const int roi_indices[],
-                              float* rois, int post_nms_topn_) {
+                              float* rois, int post_nms_topn_, int nthr) {
     const float *src_x0 = proposals + 0 * num_proposals;
     const float *src_y0 = proposals + 1 * num_proposals;
     const float *src_x1 = proposals + 2 * num_proposals;
     const float *src_y1 = proposals + 3 * num_proposals;
 
-    #pragma omp parallel for schedule(static)
-    for (int roi = 0; roi < num_rois; roi++) {
+    parallel_for(nthr, num_rois, [&](int roi) {
         int index = roi_indices[roi];
 
         const float x0 = src_x0[index];
@@ -327,7 +320,7 @@ void retrieve_rois_cpu(const int num_rois, const int item_index,
         rois[roi * 5 + 2] = y0;
         rois[roi * 5 + 3] = x1;
         rois[roi * 5 + 4] = y1;
-    }
+    });
 
     if (num_rois < post_nms_topn_) {
         for (int i = 5 * num_rois; i < 5 * post_nms_topn_; i++) {
@@ -456,15 +449,18 @@ public:
                                     anchors_shape_0, bottom_H, bottom_W, img_H, img_W,
                                     min_box_H, min_box_W, feat_stride_,
                                     box_coordinate_scale_, box_size_scale_,
-                                    coordinates_offset, initial_clip, swap_xy);
+                                    coordinates_offset, initial_clip, swap_xy,
+                                    parallelThreads(static_cast<size_t>(num_proposals) * 5));
             std::partial_sort(proposals_.begin(), proposals_.begin() + pre_nms_topn, proposals_.end(),
                               [](const ProposalBox& struct1, const ProposalBox& struct2) {
                                   return (struct1.score > struct2.score);
                               });
 
-            unpack_boxes(reinterpret_cast<float *>(&proposals_[0]), &unpacked_boxes[0], pre_nms_topn);
+            unpack_boxes(reinterpret_cast<float *>(&proposals_[0]), &unpacked_boxes[0], pre_nms_topn,
+                         parallelThreads(static_cast<size_t>(pre_nms_topn) * 4));
             nms_cpu(pre_nms_topn, &is_dead[0], &unpacked_boxes[0], &roi_indices_[0], &num_rois, 0, nms_thresh_, post_nms_topn_, coordinates_offset);
-            retrieve_rois_cpu(num_rois, n, pre_nms_topn, &unpacked_boxes[0], &roi_indices_[0], p_roi_item, post_nms_topn_);
+            retrieve_rois_cpu(num_rois, n, pre_nms_topn, &unpacked_boxes[0], &roi_indices_[0], p_roi_item, post_nms_topn_,
+                              parallelThreads(static_cast<size_t>(num_rois) * 5));
         }
 
         return OK;
@@ -515,6 +511,7 @@ public:
 
 REG_FACTORY_FOR(ProposalFactory, Proposal);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine
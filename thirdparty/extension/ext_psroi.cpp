@@ -16,6 +16,7 @@
 
 #include "ext_list.hpp"
 #include "ext_base.hpp"
+#include "parallel.h"
 #include <cmath>
 #include <vector>
 #include <string>
@@ -24,6 +25,7 @@
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
 
 class PSROIPoolingImpl: public ExtLayerBase {
 public:
@@ -70,8 +72,7 @@ public:
             }
         }
 
-        #pragma omp parallel for schedule(static)
-        for (int n = 0; n < real_rois; n++) {
+        parallel_for(parallelThreads(static_cast<size_t>(real_rois) * nc * nh * nw), real_rois, [&](int n) {
             const float* bottom_rois = bottom_rois_beginning + n * 5;
             int roi_batch_ind = static_cast<int>(bottom_rois[0]);
             float roi_start_w = static_cast<float>(round(bottom_rois[1])) * spatial_scale_;
@@ -120,19 +121,10 @@ public:
                     }
                 }
             }
-        }
+        });
 
-        #pragma omp parallel for schedule(static)
-        for (int n = real_rois; n < nn; n++) {
-            for (int c = 0; c < nc; c++) {
-                for (int h = 0; h < nh; h++) {
-                    for (int w = 0; w < nw; w++) {
-                        int index = n * nc * nh * nw + c * nh * nw + h * nw + w;
-                        dst_data[index] = 0.0f;
-                    }
-                }
-            }
-        }
+        // The output of the ROIs past the last real one is contiguous
+        std::fill(dst_data + real_rois * nc * nh * nw, dst_data + nn * nc * nh * nw, 0.0f);
 
         return OK;
     }
@@ -156,6 +148,7 @@ private:
 
 REG_FACTORY_FOR(ImplFactory<PSROIPoolingImpl>, PSROIPooling);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine
@@ -23,6 +23,7 @@
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
 
 class RegionYoloImpl: public ExtLayerBase {
 public:
@@ -87,9 +88,10 @@ public:
         if (do_softmax) {
             int index = entry_index(IW, IH, coords, classes, inputs_size, 0, 0, coords + 1);
             int batch_offset = inputs_size / num;
+            const int nthr = parallelThreads(static_cast<size_t>(classes) * IH * IW);
             for (int b = 0; b < B * num; b++)
                 softmax_generic(src_data + index + b * batch_offset, dst_data + index + b * batch_offset, 1, classes,
-                                IH, IW);
+                                IH, IW, nthr);
         }
 
         return OK;
@@ -117,6 +119,7 @@ private:
 
 REG_FACTORY_FOR(ImplFactory<RegionYoloImpl>, RegionYolo);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine
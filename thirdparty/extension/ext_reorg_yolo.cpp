@@ -21,6 +21,7 @@
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
 
 class ReorgYoloImpl: public ExtLayerBase {
 public:
@@ -78,6 +79,7 @@ private:
 
 REG_FACTORY_FOR(ImplFactory<ReorgYoloImpl>, ReorgYolo);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine
@@ -25,6 +25,7 @@
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
 
 class ResampleImpl: public ExtLayerBase {
 public:
@@ -675,6 +676,7 @@ private:
 
 REG_FACTORY_FOR(ImplFactory<ResampleImpl>, Resample);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine
@@ -25,6 +25,7 @@
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
 
 struct simpler_nms_roi_t {
     float x0, y0, x1, y1;
@@ -343,6 +344,7 @@ private:
 
 REG_FACTORY_FOR(ImplFactory<SimplerNMSImpl>, SimplerNMS);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine
@@ -26,6 +26,7 @@
 namespace InferenceEngine {
 namespace Extensions {
 namespace Cpu {
+namespace EXT_ISA_NAMESPACE {
 
 class SpatialTransformerImpl: public ExtLayerBase {
 public:
@@ -144,6 +145,7 @@ private:
 
 REG_FACTORY_FOR(ImplFactory<SpatialTransformerImpl>, SpatialTransformer);
 
+}  // namespace EXT_ISA_NAMESPACE
 }  // namespace Cpu
 }  // namespace Extensions
 }  // namespace InferenceEngine